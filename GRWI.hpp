@@ -2,15 +2,30 @@
 
 #include <exception>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <type_traits>
 #include <memory>
 #include <cstring> // for memcpy
+#include <cstdint>
 #include <functional>
 #include <limits>
 #include <iostream>
 #include <sstream>
+#include <algorithm>
+#include <iterator>
+#include <charconv> // for text parsing
 #include <forward_list> // for specialization
+#include <vector> // for contiguous layout detection
+#include <array>
+#include "gio_thread_pool.hpp" // for parallel iIOable encoding
+#include "gio_buffer_pool.hpp" // for staging buffers
+#include "gio_filter.hpp" // for filter pipelines
+#include "gio_varint.hpp" // for compact integer encoding
+#include "gio_rle.hpp" // for run length encoding
+#if __has_include(<span>)
+#include <span> // for std::span overloads, C++20
+#endif
 
 #include <cxxabi.h>
 
@@ -30,9 +45,15 @@ public:
 
 
 class iGIO;
+class gio_streambuf;
+class gio_transfer;
+class gio_record_log;
+class gio_line_index;
+class gio_parallel_reader;
 
 class iIOable {
 friend class iGIO;
+friend class gio_record_log;
 protected:
 	virtual ~iIOable() {}
 	/**
@@ -50,6 +71,26 @@ protected:
 	 */
 	virtual void toObject(const std::unique_ptr<char[]> data) = 0;
 
+	/**
+	 * @brief Writes the bytes of toBytes() into a preallocated buffer
+	 * Should be overwritten to avoid the allocation made by toBytes(), the interface's write functions use this method
+	 * @param buffer The buffer to write ObjectByteSize() bytes into
+	 */
+	virtual void copyBytes(char* buffer) const {
+		std::memcpy(buffer, toBytes().get(), ObjectByteSize());
+	}
+
+	/**
+	 * @brief Converts bytes back into derived type like toObject(), without taking ownership of the bytes
+	 * Should be overwritten to avoid the allocation needed to call toObject(), the interface's read functions use this method
+	 * @param data The ObjectByteSize() bytes to convert
+	 */
+	virtual void fromBytes(const char* data) {
+		auto copy = std::make_unique<char[]>(ObjectByteSize());
+		std::memcpy(copy.get(), data, ObjectByteSize());
+		toObject(std::move(copy));
+	}
+
 	/**
 	 * @brief The size of the object in bytes, 
 	 * IMPORTANT: This does not always equal sizeof(Type)!
@@ -60,6 +101,11 @@ protected:
 };
 
 class iGIO {
+friend class gio_streambuf;
+friend class gio_transfer;
+friend class gio_record_log;
+friend class gio_line_index;
+friend class gio_parallel_reader;
 public:
 	class IOfailure : public std::exception{
 		std::string _message;
@@ -68,6 +114,24 @@ public:
 		virtual ~IOfailure(){}
 		const char* what() const noexcept override {return _message.c_str();}
 	};
+
+	/**
+	 * @brief A contiguous byte range, used to pass multiple buffers to the interface in one call
+	 */
+	struct IOSegment {
+		const char* data;
+		std::size_t length;
+	};
+
+	/**
+	 * @brief Expected access pattern of a byte range, passed to advise()
+	 */
+	enum class access_pattern {
+		normal,		// no expectation, the default
+		sequential,	// read from front to back, e.g. read more ahead
+		random,		// read at scattered offsets, e.g. read nothing ahead
+		dont_need	// not read again soon, e.g. drop it from caches
+	};
 protected:
 	/** 
 	 * @brief Reads length amount of bytes into the passed buffer
@@ -95,6 +159,134 @@ protected:
 	 */
 	virtual std::size_t iWrite(const char* buffer, const std::size_t length) = 0;
 
+	/**
+	 * @brief Writes count segments to the interface as one transfer, e.g. the rows of a ragged container.
+	 * Should be overwritten for optimized performance, e.g. by using writev.
+	 * By default segments are coalesced into ChunkBytes sized writes, segments larger than ChunkBytes are written directly
+	 * REQUIREMENT: Has the same implemenation requirements as the default iWrite method
+	 * @param segments The segments to write, in order
+	 * @param count The amount of segments
+	 * @return std::size_t The amount of bytes written
+	 */
+	virtual std::size_t iWrite_gather(const IOSegment* segments, const std::size_t count){
+		gio_buffer_pool::buffer staging;
+		std::size_t staged = 0, written = 0;
+		for(std::size_t i = 0; i < count; i++){
+			if(staged && staged + segments[i].length > ChunkBytes)
+				written += iWrite(staging.get(), staged), staged = 0;
+			if(segments[i].length >= ChunkBytes){
+				written += iWrite(segments[i].data, segments[i].length);
+				continue;
+			}
+			if(!staging.get())
+				staging = gio_buffer_pool::local().acquire(ChunkBytes);
+			std::memcpy(staging.get() + staged, segments[i].data, segments[i].length);
+			staged += segments[i].length;
+		}
+		if(staged)
+			written += iWrite(staging.get(), staged);
+		return written;
+	}
+
+	/**
+	 * @brief File descriptor to read from the interface with, used by transfer() to copy data without entering user space
+	 * Should be overwritten by interfaces backed by a file descriptor, e.g. files, sockets and pipes.
+	 * IMPLEMENTATION: Reading from the descriptor reads the same data as iRead and advances the interface's read position
+	 * @return int The file descriptor, -1 if the interface is not backed by one
+	 */
+	virtual int iReadFd() const {
+		return -1;
+	}
+
+	/**
+	 * @brief File descriptor to write to the interface with, used by transfer() to copy data without entering user space
+	 * Should be overwritten by interfaces backed by a file descriptor, e.g. files, sockets and pipes.
+	 * IMPLEMENTATION: Writing to the descriptor has the same effect as iWrite
+	 * @return int The file descriptor, -1 if the interface is not backed by one
+	 */
+	virtual int iWriteFd() const {
+		return -1;
+	}
+
+	/**
+	 * @brief Reads length amount of bytes at offset into the passed buffer, without using or moving the read position
+	 * Should be overwritten by seekable interfaces, e.g. by using pread. By default positional reads are not supported.
+	 * IMPLEMENTATION: Has the same implemenation requirements as the default iRead method
+	 * IMPLEMENTATION: Must be safe to call from multiple threads at once for disjoint regions
+	 * @param offset The byte offset to read from
+	 * @param buffer The byte buffer to read into
+	 * @param length The amount of bytes to read
+	 * @return std::size_t The amount of bytes read, 0 past the end of the data
+	 */
+	virtual std::size_t iRead_at(const std::uint64_t offset, char* buffer, const std::size_t length){
+		(void)offset; (void)buffer; (void)length;
+		throw IOfailure("Error reading: interface does not support positional reads");
+	}
+
+	/**
+	 * @brief Writes length amount of bytes at offset, without moving the read or write position
+	 * Should be overwritten by seekable interfaces, e.g. by using pwrite. By default positional writes are not supported.
+	 * IMPLEMENTATION: Has the same implemenation requirements as the default iWrite method
+	 * @param offset The byte offset to write at
+	 * @param buffer The buffer containing the bytes to write
+	 * @param length The amount of bytes to write
+	 * @return std::size_t The amount of bytes written
+	 */
+	virtual std::size_t iWrite_at(const std::uint64_t offset, const char* buffer, const std::size_t length){
+		(void)offset; (void)buffer; (void)length;
+		throw IOfailure("Error writing: interface does not support positional writes");
+	}
+
+	/**
+	 * @brief The total amount of bytes stored behind the interface
+	 * Should be overwritten by seekable interfaces. By default the size is not known.
+	 * @return std::uint64_t The size in bytes
+	 */
+	virtual std::uint64_t iSize() const {
+		throw IOfailure("Error reading size: interface does not support positional access");
+	}
+
+	/**
+	 * @brief Moves the read position to offset
+	 * Should be overwritten by seekable interfaces, e.g. by using lseek. By default seeking is not supported.
+	 * @param offset The byte offset the next read starts at
+	 */
+	virtual void iSeek(const std::uint64_t offset){
+		(void)offset;
+		throw IOfailure("Error seeking: interface does not support positional access");
+	}
+
+	/**
+	 * @brief Pushes written data towards its destination, called by flush() and endl()
+	 * Should be overwritten by interfaces that buffer writes or offer durability, e.g. by calling fsync. By default does nothing.
+	 */
+	virtual void iFlush(){}
+
+	/**
+	 * @brief Hints that at least bytes are about to be written sequentially, called by bulk writes of ChunkBytes or more
+	 * Should be overwritten by interfaces that can prepare storage, e.g. by preallocating with fallocate. By default does nothing.
+	 * @param bytes The amount of bytes about to be written
+	 */
+	virtual void iReserve(const std::uint64_t bytes){
+		(void)bytes;
+	}
+
+	/**
+	 * @brief Hints how a byte range of the interface will be accessed
+	 * Should be overwritten by interfaces with readahead or caching, e.g. by using posix_fadvise. By default does nothing.
+	 * @param pattern The expected access pattern
+	 * @param offset The start of the range
+	 * @param length The length of the range, 0 extends it to the end
+	 */
+	virtual void iAdvise(const access_pattern pattern, const std::uint64_t offset, const std::uint64_t length){
+		(void)pattern, (void)offset, (void)length;
+	}
+
+	/**
+	 * @brief Size in bytes of the staging buffers used by bulk transfers
+	 */
+	std::size_t ChunkBytes = 64 * 1024;
+
 	/**
 	 * @brief Amount of bytes read from iRead() method between terminator comparison checks
 	 */
@@ -115,7 +307,7 @@ protected:
 	 */
 	virtual std::size_t iRead_until(char* buffer, const char* terminator, const std::size_t term_length, const std::size_t max_length = 0){
 		std::size_t _max_length = max_length ? max_length : std::numeric_limits<std::size_t>::max();
-		std::size_t i = iRead(buffer, term_length);
+		std::size_t i = _read(buffer, term_length);
 		for(std::size_t read_bytes = i, j = 0; read_bytes && i < _max_length; i+=read_bytes){
 			if(i >= term_length && term_length){ // we have enough data to check for a comparison
 				if(buffer[i-1] == terminator[j]){
@@ -126,7 +318,7 @@ protected:
 					j = 0; // reset comparison check
 			}
 			
-			read_bytes = iRead(&buffer[i], TermBytesRead); // Set TermBytesRead to the desired number of bytes, default 1
+			read_bytes = _read(&buffer[i], TermBytesRead); // Set TermBytesRead to the desired number of bytes, default 1
 		}
 		return i;
 	}
@@ -136,11 +328,26 @@ protected:
 	 */
 	const char* LineEnder = "\n";
 
+	/**
+	 * @brief Amount of iIOable objects from which array writes and reads encode and decode on the shared thread pool, 0 always encodes serially
+	 * Opt-in, copyBytes() and fromBytes() must be safe to call for different objects at the same time when enabled, e.g. 16 * 1024
+	 */
+	std::size_t ParallelThreshold = 0;
+
+	/**
+	 * @brief The characters skipped around values by the text read functions
+	 */
+	const char* TextWhitespace = " \t\r\n";
+
 	/**
 	 * @brief Custom function for flushing the interface
-	 * By default implemented as doing nothing, gets called by endl()
+	 * Calls the interface's iFlush(), which by default does nothing, gets called by endl()
 	 */
 	static iGIO& flush(iGIO& ref){
+		if(ref._filters.empty())
+			ref.iFlush();
+		else // every filter flushes the stage after it, the last one flushes the interface
+			ref._filters.front().filter->flush(ref._filters.front().next);
 		return ref;
 	}
 
@@ -150,18 +357,467 @@ protected:
 	 */
 	static iGIO& endl(iGIO& ref){
 		ref.write(ref.LineEnder);
-		return flush(ref);
+		flush(ref);
+		if(ref._on_endl)
+			ref._on_endl();
+		return ref;
+	}
+
+	/**
+	 * @brief Discards data read ahead by buffered readers like records() and read_text()
+	 * Should be called when the data behind the interface is reset
+	 */
+	void discard_read_ahead(){
+		_rbuf_begin = _rbuf_end = 0;
 	}
 
 private:
-	int _read(char* buffer, const std::size_t length){
-		return iRead(buffer, length);
+	// read-ahead buffer, filled by buffered readers like records() and drained first by every other read
+	std::unique_ptr<char[]> _rbuf;
+	std::size_t _rbuf_size  = 0;
+	std::size_t _rbuf_begin = 0;
+	std::size_t _rbuf_end   = 0;
+
+	// scratch buffer used to format text before writing it in one transfer
+	std::unique_ptr<char[]> _tbuf;
+	std::size_t _tbuf_size = 0;
+	std::size_t _tbuf_used = 0;
+
+	// set by the text and binary manipulators, selects how operator<< and operator>> handle numbers
+	bool _text_mode = false;
+
+	// called after endl() wrote a line, set by gio_line_index to index lines as they are written
+	std::function<void()> _on_endl;
+
+	// the stage after filter _index, the next filter or the interface itself
+	class _filter_stage final : public gio_filter::stage {
+		iGIO* _igio;
+		std::size_t _index;
+	public:
+		_filter_stage(iGIO* igio, const std::size_t index) : _igio(igio), _index(index) {}
+		std::size_t write(const char* data, const std::size_t length) override {
+			if(_index + 1 < _igio->_filters.size())
+				return _igio->_filters[_index + 1].filter->write(data, length, _igio->_filters[_index + 1].next);
+			return _igio->iWrite(data, length);
+		}
+		std::size_t read(char* buffer, const std::size_t length) override {
+			if(_index + 1 < _igio->_filters.size())
+				return _igio->_filters[_index + 1].filter->read(buffer, length, _igio->_filters[_index + 1].next);
+			return _igio->iRead(buffer, length);
+		}
+		void flush() override {
+			if(_index + 1 < _igio->_filters.size())
+				return _igio->_filters[_index + 1].filter->flush(_igio->_filters[_index + 1].next);
+			_igio->iFlush();
+		}
+	};
+	struct _filter_entry {
+		std::unique_ptr<gio_filter> filter;
+		_filter_stage next;
+	};
+	// attached filters, the first is nearest to the application, see add_filter()
+	std::vector<_filter_entry> _filters;
+
+	// reads through the attached filters, without filters straight from iRead()
+	std::size_t _read_filtered(char* buffer, const std::size_t length){
+		if(_filters.empty())
+			return iRead(buffer, length);
+		return _filters.front().filter->read(buffer, length, _filters.front().next);
+	}
+	void _check_unfiltered(const char* action) const {
+		if(!_filters.empty())
+			throw IOfailure(std::string("Error ") + action + ": positional access would bypass the attached filters");
+	}
+
+	std::size_t _read(char* buffer, const std::size_t length){
+		if(_rbuf_begin == _rbuf_end)
+			return _read_filtered(buffer, length);
+		std::size_t n = std::min(length, _rbuf_end - _rbuf_begin);
+		std::memcpy(buffer, _rbuf.get() + _rbuf_begin, n);
+		_rbuf_begin += n;
+		if(n < length)
+			n += _read_filtered(buffer + n, length - n);
+		return n;
 	}
-	int _read_until(char* buffer, const char* terminator, const std::size_t term_length, std::size_t max_length){
+	// positional transfers bypass the read-ahead and scratch buffers, so they can run concurrently
+	std::size_t _read_at(std::uint64_t offset, char* buffer, const std::size_t length){
+		_check_unfiltered("reading");
+		std::size_t n = 0;
+		while(n < length){
+			std::size_t r = iRead_at(offset + n, buffer + n, length - n);
+			if(!r)
+				break;
+			n += r;
+		}
+		return n;
+	}
+	std::size_t _write_at(std::uint64_t offset, const char* buffer, const std::size_t length){
+		_check_unfiltered("writing");
+		return iWrite_at(offset, buffer, length);
+	}
+
+	std::size_t _write_object(const iIOable& object){
+		const std::size_t object_size = object.ObjectByteSize();
+		auto data = gio_buffer_pool::local().acquire(object_size);
+		object.copyBytes(data.get());
+		return _write(data.get(), object_size) / object_size;
+	}
+
+	// calls body(first, last) for slices of [0, count), on the shared thread pool from ParallelThreshold elements
+	template<typename Body>
+	void _for_slices(const std::size_t count, Body&& body){
+		if(!ParallelThreshold || count < ParallelThreshold)
+			return body(std::size_t(0), count);
+		gio_thread_pool& pool = gio_thread_pool::shared();
+		const std::size_t slices = std::min(pool.size() + 1, count); // the calling thread takes a slice as well
+		pool.parallel_for(slices, [&](std::size_t i){ body(count / slices * i + count % slices * i / slices, count / slices * (i + 1) + count % slices * (i + 1) / slices); });
+	}
+	std::size_t _read_until(char* buffer, const char* terminator, const std::size_t term_length, std::size_t max_length){
+		if(_rbuf_begin != _rbuf_end || !_filters.empty()) // an overwritten iRead_until would skip the read-ahead buffer and the filters
+			return iGIO::iRead_until(buffer, terminator, term_length, max_length);
 		return iRead_until(buffer, terminator, term_length, max_length);
 	}
-	int _write(const char* buffer, const std::size_t length) {
-		return iWrite(buffer, length);
+
+	/**
+	 * @brief Reads more data into the read-ahead buffer, moving unread data to the front and growing the buffer when it is full
+	 * @return std::size_t The amount of bytes added, 0 if no data is available
+	 */
+	std::size_t _rbuf_fill(){
+		if(_rbuf_begin){
+			std::memmove(_rbuf.get(), _rbuf.get() + _rbuf_begin, _rbuf_end - _rbuf_begin);
+			_rbuf_end -= _rbuf_begin;
+			_rbuf_begin = 0;
+		}
+		if(_rbuf_end == _rbuf_size){
+			std::size_t size = std::max(ChunkBytes, _rbuf_size * 2);
+			auto grown = std::make_unique<char[]>(size);
+			if(_rbuf_end)
+				std::memcpy(grown.get(), _rbuf.get(), _rbuf_end);
+			_rbuf = std::move(grown);
+			_rbuf_size = size;
+		}
+		std::size_t n = _read_filtered(_rbuf.get() + _rbuf_end, _rbuf_size - _rbuf_end);
+		_rbuf_end += n;
+		return n;
+	}
+
+	static const char* find_terminator(const char* first, const char* last, std::string_view terminator){
+		if(terminator.empty())
+			return nullptr;
+		while(last - first >= (std::ptrdiff_t)terminator.size()){
+			first = (const char*)std::memchr(first, terminator[0], last - first - terminator.size() + 1);
+			if(!first)
+				return nullptr;
+			if(!std::memcmp(first, terminator.data(), terminator.size()))
+				return first;
+			first++;
+		}
+		return nullptr;
+	}
+
+	/**
+	 * @brief Returns length bytes to the front of the read-ahead buffer, so they are read again by the next read
+	 */
+	void _unread(const char* buffer, const std::size_t length){
+		if(!length)
+			return;
+		if(_rbuf_begin < length){ // not enough room in front of the unread data
+			const std::size_t unread = _rbuf_end - _rbuf_begin;
+			const std::size_t size = std::max(ChunkBytes, length + unread);
+			auto grown = std::make_unique<char[]>(size);
+			if(unread)
+				std::memcpy(grown.get() + length, _rbuf.get() + _rbuf_begin, unread);
+			_rbuf = std::move(grown);
+			_rbuf_size = size;
+			_rbuf_begin = length;
+			_rbuf_end = length + unread;
+		}
+		_rbuf_begin -= length;
+		std::memcpy(_rbuf.get() + _rbuf_begin, buffer, length);
+	}
+
+	// lookup table of the characters separating text values
+	using separator_table = std::array<bool, 256>;
+	separator_table _separators(std::string_view delimiters) const {
+		separator_table table = {};
+		for(const char* c = TextWhitespace; *c; c++)
+			table[(unsigned char)*c] = true;
+		for(char c : delimiters)
+			table[(unsigned char)c] = true;
+		return table;
+	}
+
+	/**
+	 * @brief Skips separators and finds the next token in the read-ahead buffer, refilling it through iRead when needed
+	 * The token stays valid until the next read.
+	 * @param separators The characters separating tokens
+	 * @param token The found token
+	 * @return bool false if no data is left
+	 */
+	bool _next_token(const separator_table& separators, std::string_view& token){
+		for(;;){
+			while(_rbuf_begin < _rbuf_end && separators[(unsigned char)_rbuf[_rbuf_begin]])
+				_rbuf_begin++;
+			if(_rbuf_begin < _rbuf_end)
+				break;
+			if(!_rbuf_fill())
+				return false;
+		}
+		std::size_t length = 0;
+		for(;;){
+			while(_rbuf_begin + length < _rbuf_end && !separators[(unsigned char)_rbuf[_rbuf_begin + length]])
+				length++;
+			if(_rbuf_begin + length < _rbuf_end || !_rbuf_fill()) // token ends at a separator or the end of data
+				break;
+		}
+		token = std::string_view(_rbuf.get() + _rbuf_begin, length);
+		_rbuf_begin += length;
+		return true;
+	}
+
+	/**
+	 * @brief Decodes up to count varints from the read-ahead buffer, refilling it through iRead when a varint is not buffered completely
+	 * @return std::size_t The amount of varints decoded, 0 if no data is left
+	 */
+	std::size_t _next_varints(std::uint64_t* out, const std::size_t count){
+		for(;;){
+			const char* first = _rbuf.get() + _rbuf_begin;
+			const std::size_t n = gio_varint::decode(first, _rbuf.get() + _rbuf_end, out, count);
+			_rbuf_begin = first - _rbuf.get();
+			if(n)
+				return n;
+			if(_rbuf_end - _rbuf_begin >= gio_varint::max_bytes)
+				throw IOfailure("Error reading: varint longer than " + std::to_string(gio_varint::max_bytes) + " bytes");
+			if(!_rbuf_fill())
+				return 0;
+		}
+	}
+
+	// more columns than any struct has, a larger count in a block means it is corrupt
+	static constexpr std::uint32_t max_columns = 65536;
+
+	// writes one field of every row as a contiguous column, gathered into ChunkBytes sized transfers
+	template<typename CT, typename Field, typename Row>
+	void _write_column(const CT& Container, const std::uint64_t rows, Field Row::* member){
+		const std::size_t per_chunk = std::max<std::size_t>(ChunkBytes / sizeof(Field), 1);
+		auto staging = gio_buffer_pool::local().acquire((std::size_t)std::min<std::uint64_t>(rows, per_chunk) * sizeof(Field));
+		std::size_t k = 0;
+		for(const Row& row : Container){
+			std::memcpy(staging.get() + k * sizeof(Field), &(row.*member), sizeof(Field));
+			if(++k == per_chunk){
+				_write(staging.get(), k * sizeof(Field));
+				k = 0;
+			}
+		}
+		if(k)
+			_write(staging.get(), k * sizeof(Field));
+	}
+
+	// reads one column and scatters it into the field of every row, a nullptr member skips the column
+	template<typename CT, typename Reader, typename Field, typename Row>
+	void _read_column(CT& Container, Reader& reader, const std::uint64_t rows, const std::uint32_t size, Field Row::* member){
+		if(size != sizeof(Field))
+			throw IOfailure("Error reading: column of " + std::to_string(size) + " byte fields read into a field of " + std::to_string(sizeof(Field)) + " bytes");
+		const std::size_t per_chunk = std::max<std::size_t>(ChunkBytes / sizeof(Field), 1);
+		auto staging = gio_buffer_pool::local().acquire((std::size_t)std::min<std::uint64_t>(rows, per_chunk) * sizeof(Field));
+		auto row = Container.begin();
+		for(std::uint64_t done = 0; done < rows;){
+			const std::size_t k = (std::size_t)std::min<std::uint64_t>(rows - done, per_chunk);
+			reader(staging.get(), k * sizeof(Field));
+			for(std::size_t i = 0; i < k; i++, ++row)
+				std::memcpy(&((*row).*member), staging.get() + i * sizeof(Field), sizeof(Field));
+			done += k;
+		}
+	}
+	template<typename CT, typename Reader>
+	void _read_column(CT&, Reader& reader, const std::uint64_t rows, const std::uint32_t size, std::nullptr_t){
+		reader(nullptr, rows * size);
+	}
+
+	// reads a block written by write_columns() through reader(buffer, length), which skips length bytes if buffer is nullptr
+	template<typename CT, typename Reader, typename... Members>
+	std::size_t _read_columns(Reader&& reader, CT& Container, Members... members){
+		std::uint64_t rows;
+		std::uint32_t columns;
+		reader((char*)&rows, sizeof(rows));
+		reader((char*)&columns, sizeof(columns));
+		if(columns < sizeof...(Members) || columns > max_columns)
+			throw IOfailure("Error reading: " + std::to_string(sizeof...(Members)) + " columns requested from a block of " + std::to_string(columns) + " columns");
+		std::vector<std::uint32_t> sizes(columns);
+		reader((char*)sizes.data(), columns * sizeof(std::uint32_t));
+		Container.resize((std::size_t)rows);
+		std::size_t i = 0;
+		(_read_column(Container, reader, rows, sizes[i++], members), ...); // in column order
+		for(; i < columns; i++)
+			reader(nullptr, rows * sizes[i]);
+		return (std::size_t)rows;
+	}
+
+	// the most bytes of elements in a run length coded block, a larger block is corrupt
+	static constexpr std::size_t max_rle_block_bytes = 64 * 1024 * 1024;
+
+	// writes count elements of size bytes as run length coded blocks of about ChunkBytes
+	void _write_rle(const char* data, const std::size_t count, const std::size_t size){
+		_tbuf_reserve(2 * gio_varint::max_bytes);
+		_tbuf_used += gio_varint::encode(count, _tbuf.get() + _tbuf_used);
+		_tbuf_used += gio_varint::encode(size, _tbuf.get() + _tbuf_used);
+		const std::size_t block = std::max<std::size_t>(std::min(ChunkBytes, max_rle_block_bytes) / size, 1);
+		for(std::size_t first = 0; first < count; first += block){
+			const std::size_t n = std::min(block, count - first);
+			const char* elements = data + first * size;
+			const gio_rle::density density = gio_rle::scan(elements, n, size);
+			const gio_rle::mode mode = gio_rle::choose(density, n, size);
+			_tbuf_reserve(2 * gio_varint::max_bytes);
+			_tbuf_used += gio_varint::encode((std::uint64_t)n << 2 | mode, _tbuf.get() + _tbuf_used);
+			if(mode == gio_rle::raw){ // written straight from the source
+				_tbuf_used += gio_varint::encode(n * size, _tbuf.get() + _tbuf_used);
+				_flush_text();
+				_write(elements, n * size);
+				continue;
+			}
+			auto encoded = gio_buffer_pool::local().acquire(gio_rle::max_encoded(n, size));
+			const std::size_t length = gio_rle::encode(mode, density, elements, n, size, encoded.get());
+			_tbuf_used += gio_varint::encode(length, _tbuf.get() + _tbuf_used);
+			_append_text(std::string_view(encoded.get(), length));
+			if(_tbuf_used >= ChunkBytes)
+				_flush_text();
+		}
+		_flush_text();
+	}
+
+	// reads the element count of data written by _write_rle()
+	std::uint64_t _read_rle_count(const std::size_t size){
+		std::uint64_t header[2];
+		if(!_next_varints(header, 1))
+			return 0;
+		if(!_next_varints(header + 1, 1))
+			throw IOfailure("Error reading: run length coded data ends in its header");
+		if(header[1] != size)
+			throw IOfailure("Error reading: run length coded elements of " + std::to_string(header[1]) + " bytes read into elements of " + std::to_string(size) + " bytes");
+		return header[0];
+	}
+	// reads the blocks of count elements, room(filled, n) returns where the n elements after the first filled ones go
+	template<typename Room>
+	void _read_rle(Room&& room, const std::uint64_t count, const std::size_t size){
+		std::unique_ptr<char[]> staging;
+		std::size_t staging_size = 0;
+		for(std::uint64_t filled = 0; filled < count;){
+			std::uint64_t header[2];
+			if(!_next_varints(header, 1) || !_next_varints(header + 1, 1))
+				throw IOfailure("Error reading: run length coded data ends after " + std::to_string(filled) + " of " + std::to_string(count) + " elements");
+			const std::uint64_t n = header[0] >> 2, length = header[1];
+			const gio_rle::mode mode = (gio_rle::mode)(header[0] & 3);
+			if(!n || n > count - filled || n > std::max<std::size_t>(max_rle_block_bytes / size, 1) || mode > gio_rle::sparse
+				|| length > gio_rle::max_encoded((std::size_t)n, size) || (mode == gio_rle::raw && length != n * size))
+				throw IOfailure("Error reading: corrupt run length coded block after " + std::to_string(filled) + " elements");
+			char* out = room(filled, (std::size_t)n);
+			char* in = out; // raw blocks are read in place
+			if(mode != gio_rle::raw){
+				if(staging_size < length){
+					staging = std::make_unique<char[]>((std::size_t)length);
+					staging_size = (std::size_t)length;
+				}
+				in = staging.get();
+			}
+			for(std::size_t r = 0; r < length;){
+				const std::size_t k = _read(in + r, (std::size_t)length - r);
+				if(!k)
+					throw IOfailure("Error reading: run length coded data ends after " + std::to_string(filled) + " of " + std::to_string(count) + " elements");
+				r += k;
+			}
+			if(mode != gio_rle::raw && !gio_rle::decode(mode, in, (std::size_t)length, out, (std::size_t)n, size))
+				throw IOfailure("Error reading: corrupt run length coded block after " + std::to_string(filled) + " elements");
+			filled += n;
+		}
+	}
+
+	// makes room for length more bytes in the scratch buffer, keeping its content
+	void _tbuf_reserve(const std::size_t length){
+		if(_tbuf_size - _tbuf_used >= length)
+			return;
+		std::size_t size = std::max(ChunkBytes, _tbuf_used + length);
+		auto grown = std::make_unique<char[]>(size);
+		if(_tbuf_used)
+			std::memcpy(grown.get(), _tbuf.get(), _tbuf_used);
+		_tbuf = std::move(grown);
+		_tbuf_size = size;
+	}
+
+	// formats a number at the end of the scratch buffer
+	template<typename Type>
+	void _format_text(const Type value){
+		constexpr std::size_t max_length = 64; // enough for any integer and the shortest round trip representation of any floating point type
+		_tbuf_reserve(max_length);
+		_tbuf_used = std::to_chars(_tbuf.get() + _tbuf_used, _tbuf.get() + _tbuf_size, value).ptr - _tbuf.get();
+	}
+	void _append_text(std::string_view text){
+		_tbuf_reserve(text.size());
+		std::memcpy(_tbuf.get() + _tbuf_used, text.data(), text.size());
+		_tbuf_used += text.size();
+	}
+	void _flush_text(){
+		std::size_t used = _tbuf_used;
+		_tbuf_used = 0; // reset first, the scratch buffer is reusable even if the write throws
+		if(used)
+			_write(_tbuf.get(), used);
+	}
+
+	template<typename Type>
+	void _parse_text(std::string_view token, Type& value){
+		const char* first = token.data();
+		const char* last  = token.data() + token.size();
+		if(first != last && *first == '+' && (last - first == 1 || first[1] != '-')) // from_chars does not accept a leading plus sign, "+-5" stays invalid
+			first++;
+		auto result = std::from_chars(first, last, value);
+		if(result.ec != std::errc() || result.ptr != last)
+			throw IOfailure("Error parsing: \"" + std::string(token) + "\" is not a valid number");
+	}
+
+	/**
+	 * @brief Finds the next record in the read-ahead buffer, refilling it through iRead when the terminator is not buffered yet
+	 * The record excludes the terminator and stays valid until the next call.
+	 * @param terminator The byte sequence that ends a record
+	 * @param record The found record
+	 * @return bool false if no data is left
+	 */
+	bool _next_record(std::string_view terminator, std::string_view& record){
+		std::size_t scanned = _rbuf_begin;
+		for(;;){
+			const char* found = find_terminator(_rbuf.get() + scanned, _rbuf.get() + _rbuf_end, terminator);
+			if(found){
+				record = std::string_view(_rbuf.get() + _rbuf_begin, found - (_rbuf.get() + _rbuf_begin));
+				_rbuf_begin = found - _rbuf.get() + terminator.size();
+				return true;
+			}
+			// rescan the bytes that could hold the start of a terminator spanning the refill
+			std::size_t unread = _rbuf_end - _rbuf_begin;
+			scanned = unread > terminator.size() ? unread - terminator.size() + 1 : 0;
+			if(!_rbuf_fill()){
+				if(_rbuf_begin == _rbuf_end)
+					return false;
+				record = std::string_view(_rbuf.get() + _rbuf_begin, _rbuf_end - _rbuf_begin);
+				_rbuf_begin = _rbuf_end;
+				return true;
+			}
+		}
+	}
+	std::size_t _write(const char* buffer, const std::size_t length) {
+		if(_filters.empty())
+			return iWrite(buffer, length);
+		return _filters.front().filter->write(buffer, length, _filters.front().next);
+	}
+	std::size_t _write_gather(const IOSegment* segments, const std::size_t count) {
+		if(_filters.empty())
+			return iWrite_gather(segments, count);
+		std::size_t n = 0;
+		for(std::size_t i = 0; i < count; i++)
+			n += _write(segments[i].data, segments[i].length);
+		return n;
+	}
+	// passes the size of a bulk write to the interface, writes below ChunkBytes are not worth a hint
+	void _reserve(const std::uint64_t bytes) {
+		if(bytes >= ChunkBytes)
+			iReserve(bytes);
 	}
 
 	// ----------------------------------------------------------------
@@ -185,6 +841,11 @@ private:
 	static std::false_type has_pushback_test(...);
 	template<class Type> using has_pushback = decltype(has_pushback_test(std::declval<Type>()));
 
+	template<typename Type, typename = decltype(std::declval<Type&>().resize(std::size_t(0)))>
+	static std::true_type  has_resize_test(const Type&);
+	static std::false_type has_resize_test(...);
+	template<class Type> using has_resize = decltype(has_resize_test(std::declval<Type>()));
+
 	template<typename Type, typename = decltype(std::declval<Type&>().push_front(*std::declval<Type&>().begin()))>
 	static std::true_type  has_pushfront_test(const Type&);
 	static std::false_type has_pushfront_test(...);
@@ -210,9 +871,10 @@ private:
 	static std::false_type is_callable_test(...); // if not have a default function
 	template<class Type> using is_callable = decltype(is_callable_test(std::declval<Type>()));
 
-	template<typename Type> using is_container = std::integral_constant<bool, has_const_iterator<Type>::value && has_begin_iterator<Type>::value && has_end_iterator<Type>::value || is_container_adapter<Type>::value>;
+	template<typename Type> using is_container = std::integral_constant<bool, (has_const_iterator<Type>::value && has_begin_iterator<Type>::value && has_end_iterator<Type>::value) || is_container_adapter<Type>::value>;
 	template<typename Type> using is_string = std::is_same<std::basic_string<typename Type::value_type, typename Type::traits_type, typename Type::allocator_type>, Type>;
 	template<typename Type> using is_stream = std::is_base_of<std::ios_base, Type>;
+	template<typename Type> using is_ioable = std::is_base_of<iIOable, typename std::remove_cv<Type>::type>;
 	
 	// is_iterator only returns true for ::iterator types, not pointers
 	template <class Type, class = void>
@@ -227,6 +889,46 @@ private:
 	template<typename InputIt>	using iterType   = typename std::iterator_traits<InputIt>::value_type;
 	template<typename CT> 		using CElemType  = typename CT::value_type;
 
+	// ----------------------------------------------------------------
+	// layout detection for bulk transfers
+	// is_flat is true for types that can be sent as raw bytes, including (nested) arrays of such types without padding
+	template<typename Type> 				struct is_flat : std::integral_constant<bool, std::is_trivially_copyable<Type>::value && !std::is_pointer<Type>::value && !is_container<Type>::value> { };
+	template<typename Type, std::size_t N>	struct is_flat<Type[N]> : is_flat<Type> { };
+	template<typename Type, std::size_t N>	struct is_flat<std::array<Type, N>> : std::integral_constant<bool, is_flat<Type>::value && sizeof(std::array<Type, N>) == N * sizeof(Type)> { };
+	
+	// is_contiguous_container is true for containers storing flat elements in one contiguous block
+	template<typename Type> 							struct is_contiguous_container : std::false_type { };
+	template<typename Type, typename Alloc> 			struct is_contiguous_container<std::vector<Type, Alloc>> : std::integral_constant<bool, is_flat<Type>::value && !std::is_same<Type, bool>::value> { };
+	template<typename Type, std::size_t N> 				struct is_contiguous_container<std::array<Type, N>> : is_flat<Type> { };
+	template<typename Type> 							struct is_basic_string : std::false_type { };
+	template<typename Type, typename Tr, typename Alloc> struct is_basic_string<std::basic_string<Type, Tr, Alloc>> : std::true_type { };
+	template<typename Type> 							struct is_string_view : std::false_type { };
+	template<typename Type, typename Tr> 				struct is_string_view<std::basic_string_view<Type, Tr>> : std::true_type { };
+	template<typename Type> using is_contiguous_leaf = std::integral_constant<bool, is_contiguous_container<typename std::remove_cv<Type>::type>::value || is_basic_string<typename std::remove_cv<Type>::type>::value>;
+
+	// is_gatherable is true for N dimensional containers of which every innermost dimension is contiguous, e.g. ragged vectors of vectors
+	template<typename Type, class = void>
+	struct is_gatherable : std::false_type { };
+	template<typename Type>
+	struct is_gatherable<Type, typename std::enable_if<is_container<Type>::value && !is_container_adapter<Type>::value, void>::type> 
+		: std::integral_constant<bool, is_contiguous_leaf<CElemType<Type>>::value || is_gatherable<CElemType<Type>>::value> { };
+
+	// is_text_number is true for arithmetic types formatted as numbers in text mode, characters and booleans are excluded
+	template<typename Type> using is_text_number = std::integral_constant<bool, std::is_arithmetic<Type>::value && !std::is_same<Type, bool>::value && 
+		!std::is_same<Type, char>::value && !std::is_same<Type, signed char>::value && !std::is_same<Type, unsigned char>::value && 
+		!std::is_same<Type, wchar_t>::value && !std::is_same<Type, char16_t>::value && !std::is_same<Type, char32_t>::value>;
+	template<typename Type, class = void>
+	struct is_text_number_container : std::false_type { };
+	template<typename Type>
+	struct is_text_number_container<Type, typename std::enable_if<is_container<Type>::value && !is_container_adapter<Type>::value, void>::type> : is_text_number<CElemType<Type>> { };
+
+	// is_column is true for pointers to flat data members of Row, stored as one column by write_columns()
+	template<typename Member, typename Row>	struct is_column : std::false_type { };
+	template<typename Field, typename Row>	struct is_column<Field Row::*, Row> : std::integral_constant<bool, is_flat<Field>::value && !std::is_function<Field>::value> { };
+	// is_column_or_skip also accepts nullptr, which skips a column in read_columns()
+	template<typename Member, typename Row> using is_column_or_skip = std::integral_constant<bool, is_column<Member, Row>::value || std::is_same<Member, std::nullptr_t>::value>;
+	// ----------------------------------------------------------------
+
 public:
 	virtual ~iGIO(){}
 
@@ -238,9 +940,9 @@ public:
 	 * @param buffer The rvalue
 	 * @return std::size_t The amount of rvalue written, 1 or 0 */
 	template<typename Type> typename std::enable_if<
-		!std::is_pointer<Type>::value && !is_container<Type>::value && !is_iterator<Type>::value && !is_stream<Type>::value && !std::is_array<Type>::value, 
+		!std::is_pointer<Type>::value && !is_container<Type>::value && !is_iterator<Type>::value && !is_stream<Type>::value && !std::is_array<Type>::value && !is_ioable<Type>::value, 
 	std::size_t>::type	write(const Type&& buffer)		  { return _write((const char*)&buffer, sizeof(Type)) / sizeof(Type); }
-	std::size_t			write(const iIOable&& buffer) { return _write(buffer.toBytes().get(), buffer.ObjectByteSize()) / buffer.ObjectByteSize(); }
+	std::size_t			write(const iIOable&& buffer) { return _write_object(buffer); }
 	// note: no rvalue read as it doesn't make sense.
 
 	//**** Pointer
@@ -251,16 +953,23 @@ public:
 	 * @param length The amount of objects in the pointer (array)
 	 * @return std::size_t The amount of Type objects written */
 	template<typename Type> typename std::enable_if<
-		std::is_pointer<Type>::value && !std::is_pointer<remPtrType<Type>>::value && !is_container<Type>::value && !is_container<remPtrType<Type>>::value && !std::is_array<remPtrType<Type>>::value && !is_iterator<Type>::value && !is_stream<remPtrType<Type>>::value,
-	std::size_t>::type	write(const Type  buffer, const std::size_t&& size) 	   { return _write((const char*)buffer, size * sizeof(remPtrType<Type>)) / sizeof(remPtrType<Type>); }
-	std::size_t 	  	write(const iIOable* buffer, const std::size_t&& size) {
-		auto data = std::make_unique<char[]>(size * buffer[0].ObjectByteSize());
-		// copy pointer buffer into byte buffer
-		for(std::size_t i = 0; i < size; i++)
-			std::memcpy(data.get() + i * buffer[0].ObjectByteSize(),
-				buffer[i].toBytes().get(), buffer[0].ObjectByteSize());
+		std::is_pointer<Type>::value && !std::is_pointer<remPtrType<Type>>::value && !is_container<Type>::value && !is_container<remPtrType<Type>>::value && !std::is_array<remPtrType<Type>>::value && !is_iterator<Type>::value && !is_stream<remPtrType<Type>>::value && !is_ioable<remPtrType<Type>>::value,
+	std::size_t>::type	write(const Type  buffer, const std::size_t size) 	   { return _write((const char*)buffer, size * sizeof(remPtrType<Type>)) / sizeof(remPtrType<Type>); }
+	template<typename Type> typename std::enable_if<
+		is_ioable<Type>::value, 
+	std::size_t>::type	write(const Type* buffer, const std::size_t size) {
+		if(!size)
+			return 0;
+		const std::size_t object_size = static_cast<const iIOable&>(buffer[0]).ObjectByteSize();
+		auto data = gio_buffer_pool::local().acquire(size * object_size);
+		_reserve(size * object_size);
+		// copy pointer buffer into byte buffer, every slice encodes into its own part of the buffer
+		_for_slices(size, [&](std::size_t first, std::size_t last){
+			for(std::size_t i = first; i < last; i++)
+				static_cast<const iIOable&>(buffer[i]).copyBytes(data.get() + i * object_size);
+		});
 		// write all data at once
-		return _write(data.get(), size * buffer[0].ObjectByteSize()) / buffer[0].ObjectByteSize();
+		return _write(data.get(), size * object_size) / object_size;
 	}
 	std::size_t	 	  	write(const char* string) { return _write(string, std::strlen(string)); }
 
@@ -272,19 +981,23 @@ public:
 	 * @param length The amount of objects in the pointer (array)
 	 * @return std::size_t The amount of Type objects written */
 	template<typename Type> typename std::enable_if<
-		std::is_pointer<Type>::value && !std::is_pointer<remPtrType<Type>>::value && !is_container<Type>::value && !is_container<remPtrType<Type>>::value && !std::is_array<remPtrType<Type>>::value && !is_iterator<Type>::value && !is_stream<remPtrType<Type>>::value, 
+		std::is_pointer<Type>::value && !std::is_pointer<remPtrType<Type>>::value && !is_container<Type>::value && !is_container<remPtrType<Type>>::value && !std::is_array<remPtrType<Type>>::value && !is_iterator<Type>::value && !is_stream<remPtrType<Type>>::value && !is_ioable<remPtrType<Type>>::value, 
 	std::size_t>::type 	read(Type buffer, const std::size_t size) 		  { return _read((char*)buffer, size * sizeof(remPtrType<Type>)) / sizeof(remPtrType<Type>); }
-	std::size_t 		read(iIOable* buffer, const std::size_t size) {
+	template<typename Type> typename std::enable_if<
+		is_ioable<Type>::value, 
+	std::size_t>::type	read(Type* buffer, const std::size_t size) {
+		if(!size)
+			return 0;
+		const std::size_t object_size = static_cast<const iIOable&>(buffer[0]).ObjectByteSize();
 		// create buffer, and read into it
-		auto data = std::make_unique<char[]>(size * buffer[0].ObjectByteSize());
-		auto bytesread = _read(data.get(), size * buffer[0].ObjectByteSize());
-		// copy buffered data into objects
-		for(std::size_t i = 0; i < size; i++){
-			auto data_temp = std::make_unique<char[]>(buffer[0].ObjectByteSize());
-			std::memcpy(data_temp.get(), data.get() + i * buffer[0].ObjectByteSize(), buffer[0].ObjectByteSize());
-			buffer[i].toObject(std::move(data_temp));
-		}
-		return bytesread / buffer[0].ObjectByteSize();
+		auto data = gio_buffer_pool::local().acquire(size * object_size);
+		auto bytesread = _read(data.get(), size * object_size);
+		// copy buffered data into objects, every slice decodes its own part of the buffer
+		_for_slices(size, [&](std::size_t first, std::size_t last){
+			for(std::size_t i = first; i < last; i++)
+				static_cast<iIOable&>(buffer[i]).fromBytes(data.get() + i * object_size);
+		});
+		return bytesread / object_size;
 	}	
 	
 	/** @brief Reads until either length is reached or terminator is reached
@@ -297,41 +1010,41 @@ public:
 	 * @param maxlength The maximum amount of Type elements to read
 	 * @return sts::size_t The amount of Type elements read */
 	template<typename Type> typename std::enable_if<
-		std::is_pointer<Type>::value && !std::is_pointer<remPtrType<Type>>::value && !is_container<Type>::value && !is_container<remPtrType<Type>>::value && !std::is_array<remPtrType<Type>>::value && !is_iterator<Type>::value && !is_stream<remPtrType<Type>>::value, 
+		std::is_pointer<Type>::value && !std::is_pointer<remPtrType<Type>>::value && !is_container<Type>::value && !is_container<remPtrType<Type>>::value && !std::is_array<remPtrType<Type>>::value && !is_iterator<Type>::value && !is_stream<remPtrType<Type>>::value && !is_ioable<remPtrType<Type>>::value, 
 	std::size_t>::type	read_until(Type buffer, const remPtrType<Type>& terminator, const std::size_t maxlength) {
 		return _read_until((char*)buffer, (char*)&terminator, sizeof(remPtrType<Type>), maxlength * sizeof(remPtrType<Type>)) / sizeof(Type);
 	}
 	template<typename Type, typename Type2> typename std::enable_if<
-		std::is_pointer<Type>::value && !std::is_pointer<remPtrType<Type>>::value && !is_container<Type>::value && !is_container<remPtrType<Type>>::value && !std::is_array<remPtrType<Type>>::value && !is_iterator<Type>::value && !is_stream<remPtrType<Type>>::value &&
+		std::is_pointer<Type>::value && !std::is_pointer<remPtrType<Type>>::value && !is_container<Type>::value && !is_container<remPtrType<Type>>::value && !std::is_array<remPtrType<Type>>::value && !is_iterator<Type>::value && !is_stream<remPtrType<Type>>::value && !is_ioable<remPtrType<Type>>::value &&
 		std::is_pointer<Type2>::value && !is_container<Type2>::value && !std::is_array<Type2>::value && !is_iterator<Type2>::value && !is_stream<Type2>::value, 
 	std::size_t>::type	read_until(Type buffer, const Type2& terminator, const std::size_t maxlength) {
 		return _read_until((char*)buffer, (char*)&terminator, sizeof(Type2), maxlength * sizeof(remPtrType<Type>)) / sizeof(Type);
 	}
-	template<typename Type> typename std::enable_if<
-		!std::is_pointer<Type>::value && !is_container<Type>::value && !std::is_array<remPtrType<Type>>::value && !is_iterator<Type>::value && !is_stream<remPtrType<Type>>::value, 
-	std::size_t>::type	read_until(iIOable* buffer, const Type& terminator, const std::size_t maxlength) {
+	template<typename Type, typename TT> typename std::enable_if<
+		is_ioable<Type>::value && !std::is_pointer<TT>::value && !is_container<TT>::value && !std::is_array<remPtrType<TT>>::value && !is_iterator<TT>::value && !is_stream<remPtrType<TT>>::value && !is_ioable<TT>::value, 
+	std::size_t>::type	read_until(Type* buffer, const TT& terminator, const std::size_t maxlength) {
+		const std::size_t object_size = static_cast<const iIOable&>(buffer[0]).ObjectByteSize();
 		// create buffer, and read into it
-		auto data = std::make_unique<char[]>(maxlength * buffer[0].ObjectByteSize());
-		auto bytesread = _read_until(data.get(), (char*)&terminator, sizeof(terminator), maxlength * buffer[0].ObjectByteSize());
+		auto data = gio_buffer_pool::local().acquire(maxlength * object_size);
+		auto bytesread = _read_until(data.get(), (char*)&terminator, sizeof(terminator), maxlength * object_size);
 		// copy buffered data into objects
-		for(std::size_t i = 0; i < maxlength; i++){
-			auto data_temp = std::make_unique<char[]>(buffer[0].ObjectByteSize());
-			std::memcpy(data_temp.get(), data.get() + i * buffer[0].ObjectByteSize(), buffer[0].ObjectByteSize());
-			buffer[i].toObject(std::move(data_temp));
-		}
-		return bytesread / buffer[0].ObjectByteSize();
+		for(std::size_t i = 0; i < maxlength; i++)
+			static_cast<iIOable&>(buffer[i]).fromBytes(data.get() + i * object_size);
+		return bytesread / object_size;
 	}
-	std::size_t 		read_until(iIOable* buffer, const iIOable& terminator, const std::size_t maxlength) {
+	template<typename Type> typename std::enable_if<
+		is_ioable<Type>::value, 
+	std::size_t>::type	read_until(Type* buffer, const iIOable& terminator, const std::size_t maxlength) {
+		const std::size_t object_size = static_cast<const iIOable&>(buffer[0]).ObjectByteSize();
 		// create buffer, and read into it
-		auto data = std::make_unique<char[]>(maxlength * buffer[0].ObjectByteSize());
-		auto bytesread = _read_until(data.get(), terminator.toBytes().get(), terminator.ObjectByteSize(), maxlength * buffer[0].ObjectByteSize());
+		auto data = gio_buffer_pool::local().acquire(maxlength * object_size);
+		auto term = gio_buffer_pool::local().acquire(terminator.ObjectByteSize());
+		terminator.copyBytes(term.get());
+		auto bytesread = _read_until(data.get(), term.get(), terminator.ObjectByteSize(), maxlength * object_size);
 		// copy buffered data into objects
-		for(std::size_t i = 0; i < maxlength; i++){
-			auto data_temp = std::make_unique<char[]>(buffer[0].ObjectByteSize());
-			std::memcpy(data_temp.get(), data.get() + i * buffer[0].ObjectByteSize(), buffer[0].ObjectByteSize());
-			buffer[i].toObject(std::move(data_temp));
-		}
-		return bytesread / buffer[0].ObjectByteSize();
+		for(std::size_t i = 0; i < maxlength; i++)
+			static_cast<iIOable&>(buffer[i]).fromBytes(data.get() + i * object_size);
+		return bytesread / object_size;
 	}	
 
 	//**** Array
@@ -345,12 +1058,23 @@ public:
 	 * @param write_ending_0 boolean indicating if ending 0 should be written, only implemented for c-style strings
 	 * @return std::size_t The amount of Type objects written */
 	template<typename Type, std::size_t size> typename std::enable_if<
-		!std::is_pointer<Type>::value && !is_container<Type>::value && !is_iterator<Type>::value  && !std::is_array<Type>::value && !is_stream<Type>::value, 
+		!std::is_pointer<Type>::value && !is_container<Type>::value && !is_iterator<Type>::value  && !std::is_array<Type>::value && !is_stream<Type>::value && !is_ioable<Type>::value, 
 	std::size_t>::type 	write(const Type(&buffer)[size]) 		{ return _write((const char*)buffer, size * sizeof(Type)) / sizeof(Type); }
 	template<std::size_t size>
 	std::size_t		 	write(const char(&buffer)[size], const bool write_ending_0 = 0) { return _write((const char*)buffer, size-(!write_ending_0)); }
-	template<std::size_t size>
-	std::size_t 		write(const iIOable(&buffer)[size]) { return write(buffer, size); }
+	template<typename Type, std::size_t size> typename std::enable_if<
+		is_ioable<Type>::value, 
+	std::size_t>::type 	write(const Type(&buffer)[size]) { return write(&buffer[0], size); }
+
+	/** @brief Writes a multidimensional array to the interface in a single transfer
+	 * SUPPORTS: Any multidimensional array of types that can be sent as raw bytes, excluding pointer arrays, containers and iterators
+	 * @tparam Type The type of the inner array, e.g. int[2] for int[4][2]
+	 * @tparam size The size of the outer dimension
+	 * @param buffer The buffer to write
+	 * @return std::size_t The amount of innermost elements written */
+	template<typename Type, std::size_t size> typename std::enable_if<
+		std::is_array<Type>::value && is_flat<Type>::value, 
+	std::size_t>::type 	write(const Type(&buffer)[size]) 		{ return _write((const char*)buffer, sizeof(buffer)) / sizeof(typename std::remove_all_extents<Type>::type); }
 
 	/** @brief Writes an array of arrays to the interface
 	 * SUPPORTS: Any pointer array excluding multidimensional arrays, containers and iterators
@@ -366,7 +1090,7 @@ public:
 		// writes array of pointer arrays with same size to the interface
 		std::size_t types_written = 0;
 		for(std::size_t i = 0; i < size; i++)
-			types_written += write(buffer[i], elementsize) / sizeof(Type);
+			types_written += write(buffer[i], elementsize);
 		return types_written;
 	}
 	
@@ -377,10 +1101,21 @@ public:
 	 * @param buffer The buffer to read into
 	 * @return std::size_t The amount of Type objects read */
 	template<typename Type, std::size_t size> typename std::enable_if<
-		!std::is_pointer<Type>::value && !is_container<Type>::value && !is_iterator<Type>::value  && !std::is_array<Type>::value && !is_stream<Type>::value, 
+		!std::is_pointer<Type>::value && !is_container<Type>::value && !is_iterator<Type>::value  && !std::is_array<Type>::value && !is_stream<Type>::value && !is_ioable<Type>::value, 
 	std::size_t>::type 	read(Type(&buffer)[size]) 	 { return _read((char*)buffer, size * sizeof(Type)) / sizeof(Type); }
-	template<std::size_t size>
-	std::size_t 		read(iIOable(&buffer)[size]) { return read(buffer, size); }
+	template<typename Type, std::size_t size> typename std::enable_if<
+		is_ioable<Type>::value, 
+	std::size_t>::type 	read(Type(&buffer)[size]) { return read(&buffer[0], size); }
+	
+	/** @brief Reads a multidimensional array from the interface in a single transfer
+	 * SUPPORTS: Any multidimensional array of types that can be sent as raw bytes, excluding pointer arrays, containers and iterators
+	 * @tparam Type The type of the inner array, e.g. int[2] for int[4][2]
+	 * @tparam size The size of the outer dimension
+	 * @param buffer The buffer to read into
+	 * @return std::size_t The amount of innermost elements read */
+	template<typename Type, std::size_t size> typename std::enable_if<
+		std::is_array<Type>::value && is_flat<Type>::value, 
+	std::size_t>::type 	read(Type(&buffer)[size]) 	 { return _read((char*)buffer, sizeof(buffer)) / sizeof(typename std::remove_all_extents<Type>::type); }
 	
 	/** @brief Reads arrays of elementsize from the interface into the specified array
 	 * SUPPORTS: Any pointer array excluding multidimensional arrays, containers and iterators
@@ -407,17 +1142,18 @@ public:
 	 * @param terminator The terminator to search for terminator
 	 * @return sts::size_t The amount of Type read */
 	template<typename Type, std::size_t size> typename std::enable_if<
-		!std::is_pointer<Type>::value && !is_container<Type>::value && !is_iterator<Type>::value && !std::is_array<Type>::value && !is_stream<Type>::value,
+		!std::is_pointer<Type>::value && !is_container<Type>::value && !is_iterator<Type>::value && !std::is_array<Type>::value && !is_stream<Type>::value && !is_ioable<Type>::value,
 	std::size_t>::type	read_until(Type(&buffer)[size], const Type& terminator) { return read_until(&buffer[0], terminator, size * sizeof(Type)); }
 	template<typename Type, typename Type2, std::size_t size> typename std::enable_if<
-		!std::is_pointer<Type>::value && !is_container<Type>::value && !is_iterator<Type>::value && !std::is_array<Type>::value && !is_stream<Type>::value &&
+		!std::is_pointer<Type>::value && !is_container<Type>::value && !is_iterator<Type>::value && !std::is_array<Type>::value && !is_stream<Type>::value && !is_ioable<Type>::value &&
 		!std::is_pointer<Type2>::value && !is_container<Type2>::value && !is_iterator<Type2>::value && !std::is_array<Type2>::value && !is_stream<Type2>::value,
 	std::size_t>::type	read_until(Type(&buffer)[size], const Type2& terminator) { return read_until(&buffer[0], terminator, size * sizeof(Type)); }
-	template<std::size_t size, typename TT> typename std::enable_if<
-		!std::is_pointer<TT>::value && !is_container<TT>::value && !is_iterator<TT>::value && !std::is_array<TT>::value && !is_stream<TT>::value,
-	std::size_t>::type	read_until(iIOable(&buffer)[size], const TT& terminator) { return read_until(&buffer[0], terminator, size * buffer[0].ObjectByteSize()); }
-	template<std::size_t size>
-	std::size_t 		read_until(iIOable(&buffer)[size], const iIOable& terminator) { return read_until(&buffer[0], terminator, size * buffer[0].ObjectByteSize());	}	
+	template<typename Type, std::size_t size, typename TT> typename std::enable_if<
+		is_ioable<Type>::value && !std::is_pointer<TT>::value && !is_container<TT>::value && !is_iterator<TT>::value && !std::is_array<TT>::value && !is_stream<TT>::value && !is_ioable<TT>::value,
+	std::size_t>::type	read_until(Type(&buffer)[size], const TT& terminator) { return read_until(&buffer[0], terminator, size); }
+	template<typename Type, std::size_t size> typename std::enable_if<
+		is_ioable<Type>::value, 
+	std::size_t>::type	read_until(Type(&buffer)[size], const iIOable& terminator) { return read_until(&buffer[0], terminator, size); }
 
 	//**** lvalue
 	/** @brief Writes an lvalue to the interface
@@ -426,9 +1162,9 @@ public:
 	 * @param buffer The lvalue
 	 * @return std::size_t The amount of lvalue written, 1 or 0 */
 	template<typename Type> typename std::enable_if<
-		!std::is_pointer<Type>::value && !is_container<Type>::value && !is_iterator<Type>::value && !is_stream<Type>::value && !std::is_array<Type>::value, 
+		!std::is_pointer<Type>::value && !is_container<Type>::value && !is_iterator<Type>::value && !is_stream<Type>::value && !std::is_array<Type>::value && !is_ioable<Type>::value, 
 	std::size_t>::type 	write(const Type& buffer) 	  	 { return _write((const char*)&buffer, sizeof(Type)) / sizeof(Type); }
-	std::size_t 		write(const iIOable& buffer) { return _write(buffer.toBytes().get(), buffer.ObjectByteSize()) / buffer.ObjectByteSize(); }
+	std::size_t 		write(const iIOable& buffer) { return _write_object(buffer); }
 	
 	/** @brief Reads an lvalue from the interface
 	 * SUPPORTS: Every lvalue excluding pointers, arrays, containers, iterators and streams
@@ -436,12 +1172,12 @@ public:
 	 * @param buffer The lvalue
 	 * @return std::size_t The amount of lvalue written, 1 or 0 */
 	template<typename Type> typename std::enable_if<
-		!std::is_pointer<Type>::value && !is_container<Type>::value && !is_iterator<Type>::value && !is_stream<Type>::value && !std::is_array<Type>::value, 
+		!std::is_pointer<Type>::value && !is_container<Type>::value && !is_iterator<Type>::value && !is_stream<Type>::value && !std::is_array<Type>::value && !is_ioable<Type>::value, 
 	std::size_t>::type 	read(Type& buffer)		  { return _read((char*)&buffer, sizeof(Type)) / sizeof(Type); }
 	std::size_t			read(iIOable& buffer) {
-		auto data = std::make_unique<char[]>(buffer.ObjectByteSize());
+		auto data = gio_buffer_pool::local().acquire(buffer.ObjectByteSize());
 		auto bytesread = _read(data.get(),   buffer.ObjectByteSize());
-		buffer.toObject(std::move(data));
+		buffer.fromBytes(data.get());
 		return bytesread / buffer.ObjectByteSize();
 	}
 
@@ -560,6 +1296,8 @@ public:
 	template<typename InputIt> constexpr typename std::enable_if<
 		!is_container<iterType<InputIt>>::value && is_iterator<InputIt>::value, 
 	InputIt>::type	write(InputIt first, InputIt last) {
+		if constexpr(std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>::value && is_flat<iterType<InputIt>>::value)
+			_reserve((std::uint64_t)std::distance(first, last) * sizeof(iterType<InputIt>));
 		for(; first!=last; ++first)
 			write(*first);
 		return last;
@@ -598,18 +1336,60 @@ public:
 	}
 	
 	/** @brief Writes an N dimensional container to the interface, unwrapping every dimension
-	 * SUPPORTS: Any iterator type
+	 * SUPPORTS: Any iterator type of which the innermost dimension is not contiguous
 	 * @tparam InputIt The iterator type 
 	 * @param first Iterator pointing to the start of range
 	 * @param last  Iterator pointing to the end of range
 	 * @return InputIt::iterator Iterator pointing to the last element send */
 	template<typename InputIt> constexpr typename std::enable_if<
-		is_container<iterType<InputIt>>::value && is_iterator<InputIt>::value, 
+		is_container<iterType<InputIt>>::value && is_iterator<InputIt>::value && !is_contiguous_leaf<iterType<InputIt>>::value && !is_gatherable<iterType<InputIt>>::value, 
 	InputIt>::type	write(InputIt first, InputIt last) {
 		for(; first!=last; ++first)
 			write(first->begin(), first->end()); // no need to check output as it will throw on error
 		return last;
 	}
+	/** @brief Writes an N dimensional container to the interface as a single gather write,
+	 * every contiguous innermost dimension (row) is passed to the interface as one segment of its own length
+	 * SUPPORTS: Any iterator type of which the innermost dimension is contiguous, e.g. ragged vectors of vectors
+	 * @tparam InputIt The iterator type 
+	 * @param first Iterator pointing to the start of range
+	 * @param last  Iterator pointing to the end of range
+	 * @return InputIt::iterator Iterator pointing to the last element send */
+	template<typename InputIt> typename std::enable_if<
+		is_container<iterType<InputIt>>::value && is_iterator<InputIt>::value && (is_contiguous_leaf<iterType<InputIt>>::value || is_gatherable<iterType<InputIt>>::value), 
+	InputIt>::type	write(InputIt first, InputIt last) {
+		std::vector<IOSegment> segments;
+		for(; first!=last; ++first)
+			gather_segments(*first, segments);
+		std::uint64_t bytes = 0;
+		for(const IOSegment& segment : segments)
+			bytes += segment.length;
+		_reserve(bytes);
+		_write_gather(segments.data(), segments.size());
+		return last;
+	}
+
+private:
+	// appends a contiguous row as a segment, merging it with the previous segment if they are adjacent in memory
+	template<typename CT> typename std::enable_if<
+		is_contiguous_leaf<CT>::value,
+	void>::type	gather_segments(const CT& row, std::vector<IOSegment>& segments) {
+		const std::size_t length = row.size() * sizeof(CElemType<CT>);
+		if(!length)
+			return;
+		if(!segments.empty() && segments.back().data + segments.back().length == (const char*)row.data())
+			segments.back().length += length;
+		else
+			segments.push_back({(const char*)row.data(), length});
+	}
+	// unwraps a dimension until the contiguous rows are reached
+	template<typename CT> typename std::enable_if<
+		!is_contiguous_leaf<CT>::value && is_gatherable<CT>::value,
+	void>::type	gather_segments(const CT& Container, std::vector<IOSegment>& segments) {
+		for(const auto& elem : Container)
+			gather_segments(elem, segments);
+	}
+public:
 
 private:
 	template<typename BT, class predicate>
@@ -652,13 +1432,38 @@ public:
 	 * @param Container The container to write
 	 * @return InputIt::iterator Iterator pointing to the last element send */
 	template<typename CT> constexpr typename std::enable_if<
-		is_container<CT>::value && !std::is_pointer<CElemType<CT>>::value && !is_container_adapter<CT>::value, 
+		is_container<CT>::value && !std::is_pointer<CElemType<CT>>::value && !is_container_adapter<CT>::value && !is_contiguous_container<typename std::remove_cv<CT>::type>::value && !is_string_view<typename std::remove_cv<CT>::type>::value, 
 	std::size_t>::type	write(CT& Container) {
+		if constexpr(is_flat<CElemType<CT>>::value && !std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<decltype(Container.begin())>::iterator_category>::value)
+			_reserve((std::uint64_t)Container.size() * sizeof(CElemType<CT>)); // the range write can only measure random access ranges
 		auto iterlast = write(Container.begin(), Container.end());
 		if(iterlast == Container.end())
 			return Container.size();
 		return std::distance(Container.begin(), iterlast);
 	}
+	/** @brief Writes a contiguous container to the interface in a single transfer
+	 * SUPPORTS: std::vector and std::array of types that can be sent as raw bytes, including nested std::arrays
+	 * @tparam CT The container type
+	 * @param Container The container to write
+	 * @return std::size_t The amount of CT's type written */
+	template<typename CT> typename std::enable_if<
+		is_contiguous_container<typename std::remove_cv<CT>::type>::value, 
+	std::size_t>::type	write(CT& Container) {
+		_reserve(Container.size() * sizeof(CElemType<CT>));
+		return _write((const char*)Container.data(), Container.size() * sizeof(CElemType<CT>)) / sizeof(CElemType<CT>);
+	}
+
+	/** @brief Reads a fixed size std::array from the interface in a single transfer
+	 * SUPPORTS: std::array of types that can be sent as raw bytes, including nested std::arrays
+	 * @tparam Type The element type
+	 * @tparam size The size of the array
+	 * @param Container The array to read into
+	 * @return std::size_t The amount of Type elements read */
+	template<typename Type, std::size_t size> typename std::enable_if<
+		is_flat<Type>::value, 
+	std::size_t>::type	read(std::array<Type, size>& Container) {
+		return _read((char*)Container.data(), size * sizeof(Type)) / sizeof(Type);
+	}
 	template<typename T>
 	std::size_t write(std::forward_list<T>& Container){
 		auto iterlast = write(Container.begin(), Container.end());
@@ -839,38 +1644,638 @@ public:
 		return read_into_T_until(StrPushLambda, terminator, maxlength);
 	}
 
+	//? ======== View R/W wrappers ========>>==========================================================================================
+
+	/** @brief Writes the characters referenced by a string view to the interface, without copying
+	 * SUPPORTS: any string_view type
+	 * @tparam CharT The character type
+	 * @tparam Traits The character traits
+	 * @param view The string view
+	 * @return std::size_t The amount of characters written */
+	template<typename CharT, typename Traits>
+	std::size_t			write(std::basic_string_view<CharT, Traits> view) { return _write((const char*)view.data(), view.size() * sizeof(CharT)) / sizeof(CharT); }
+
+#ifdef __cpp_lib_span
+	/** @brief Writes the elements referenced by a span to the interface in a single transfer, without copying
+	 * SUPPORTS: Any span of types that can be sent as raw bytes
+	 * @tparam Type The element type
+	 * @tparam Extent The extent of the span
+	 * @param view The span to write
+	 * @return std::size_t The amount of Type elements written */
+	template<typename Type, std::size_t Extent> typename std::enable_if<
+		is_flat<typename std::remove_cv<Type>::type>::value, 
+	std::size_t>::type	write(std::span<Type, Extent> view) { return _write((const char*)view.data(), view.size_bytes()) / sizeof(Type); }
+
+	/** @brief Reads from the interface into the preallocated memory referenced by a span in a single transfer
+	 * SUPPORTS: Any span of non const types that can be sent as raw bytes
+	 * @tparam Type The element type
+	 * @tparam Extent The extent of the span
+	 * @param buffer The span to read into
+	 * @return std::size_t The amount of Type elements read */
+	template<typename Type, std::size_t Extent> typename std::enable_if<
+		!std::is_const<Type>::value && is_flat<Type>::value, 
+	std::size_t>::type	read(std::span<Type, Extent> buffer) { return _read((char*)buffer.data(), buffer.size_bytes()) / sizeof(Type); }
+#endif
+
+	//? ======== Filters ========>>==========================================================================================
+	// Filters transform the bytes between the read and write functions and the backend, see gio_filter.
+	// Without filters reads and writes go straight to iRead()/iWrite(). Positional access throws IOfailure while filters are attached.
+
+	/** @brief Attaches a filter nearest to the backend, after the filters already attached, which are flushed first
+	 * @tparam Filter The filter type, derived from gio_filter
+	 * @param args The arguments passed to the constructor of Filter
+	 * @return Filter& The attached filter */
+	template<typename Filter, typename... Args>
+	Filter&				add_filter(Args&&... args) {
+		static_assert(std::is_base_of<gio_filter, Filter>::value, "filters must derive from gio_filter");
+		if(!_filters.empty())
+			flush(*this);
+		auto filter = std::make_unique<Filter>(std::forward<Args>(args)...);
+		Filter& attached = *filter;
+		_filters.push_back({std::move(filter), _filter_stage(this, _filters.size())});
+		return attached;
+	}
+
+	/** @brief Flushes, finishes and detaches all filters, should be called before the backend is closed when filters keep bytes until flush()
+	 * or end their stream with a marker, see gio_filter::finish() */
+	void				remove_filters() {
+		if(_filters.empty())
+			return;
+		flush(*this);
+		for(_filter_entry& entry : _filters)
+			entry.filter->finish(entry.next);
+		_filters.clear();
+		flush(*this); // the backend, the filters are detached
+	}
+
+	/** @brief The amount of attached filters */
+	std::size_t			filter_count() const { return _filters.size(); }
+
+	//? ======== Positional R/W wrappers ========>>==========================================================================================
+	// Positional functions read and write at a byte offset without using or moving the read position of the interface.
+	// Reads do not share state with each other, multiple threads can read disjoint regions of one interface at once.
+	// Throws IOfailure if the interface does not support positional access.
+
+	/** @brief The total amount of bytes stored behind the interface
+	 * @return std::uint64_t The size in bytes */
+	std::uint64_t		size() const { return iSize(); }
+
+	/** @brief Moves the read position to offset, data read ahead by buffered readers is discarded
+	 * @param offset The byte offset the next read starts at */
+	void				seek(const std::uint64_t offset) { discard_read_ahead(); iSeek(offset); }
+
+	/** @brief Hints that at least bytes are about to be written, e.g. to preallocate storage
+	 * Bulk container, range and iIOable array writes of ChunkBytes or more pass their size automatically
+	 * @param bytes The amount of bytes about to be written */
+	void				reserve(const std::uint64_t bytes) { iReserve(bytes); }
+
+	/** @brief Hints how a byte range of the interface will be accessed, e.g. to tune readahead
+	 * @param pattern The expected access pattern
+	 * @param offset The start of the range
+	 * @param length The length of the range, 0 extends it to the end */
+	void				advise(const access_pattern pattern, const std::uint64_t offset = 0, const std::uint64_t length = 0) { iAdvise(pattern, offset, length); }
+
+	/** @brief Writes an lvalue at offset
+	 * SUPPORTS: Any type that can be sent as raw bytes, excluding pointers, arrays and containers
+	 * @tparam Type The type of the lvalue
+	 * @param offset The byte offset to write at
+	 * @param buffer The lvalue
+	 * @return std::size_t The amount of lvalue written, 1 or 0 */
+	template<typename Type> typename std::enable_if<
+		is_flat<Type>::value && !std::is_array<Type>::value && !is_contiguous_leaf<Type>::value, 
+	std::size_t>::type	write_at(const std::uint64_t offset, const Type& buffer) { return _write_at(offset, (const char*)&buffer, sizeof(Type)) / sizeof(Type); }
+	std::size_t			write_at(const std::uint64_t offset, const iIOable& buffer) {
+		auto data = gio_buffer_pool::local().acquire(buffer.ObjectByteSize());
+		buffer.copyBytes(data.get());
+		return _write_at(offset, data.get(), buffer.ObjectByteSize()) / buffer.ObjectByteSize();
+	}
+
+	/** @brief Writes a pointer buffer of size length at offset
+	 * SUPPORTS: Any pointer to types that can be sent as raw bytes
+	 * @tparam Type The element type
+	 * @param offset The byte offset to write at
+	 * @param buffer The pointer buffer
+	 * @param size The amount of objects in the pointer (array)
+	 * @return std::size_t The amount of Type objects written */
+	template<typename Type> typename std::enable_if<
+		is_flat<Type>::value, 
+	std::size_t>::type	write_at(const std::uint64_t offset, const Type* buffer, const std::size_t size) { return _write_at(offset, (const char*)buffer, size * sizeof(Type)) / sizeof(Type); }
+	std::size_t			write_at(const std::uint64_t offset, const char* string) { return _write_at(offset, string, std::strlen(string)); }
+
+	/** @brief Writes a contiguous container or string at offset in a single transfer
+	 * SUPPORTS: std::vector, std::array and std::basic_string of types that can be sent as raw bytes
+	 * @tparam CT The container type
+	 * @param offset The byte offset to write at
+	 * @param Container The container to write
+	 * @return std::size_t The amount of CT's type written */
+	template<typename CT> typename std::enable_if<
+		is_contiguous_leaf<CT>::value, 
+	std::size_t>::type	write_at(const std::uint64_t offset, const CT& Container) { return write_at(offset, Container.data(), Container.size()); }
+
+	/** @brief Writes the characters referenced by a string view at offset
+	 * @tparam CharT The character type
+	 * @tparam Traits The character traits
+	 * @param offset The byte offset to write at
+	 * @param view The string view
+	 * @return std::size_t The amount of characters written */
+	template<typename CharT, typename Traits>
+	std::size_t			write_at(const std::uint64_t offset, std::basic_string_view<CharT, Traits> view) { return write_at(offset, view.data(), view.size()); }
+
+	/** @brief Reads an lvalue from offset
+	 * SUPPORTS: Any type that can be sent as raw bytes, excluding pointers, arrays and containers
+	 * @tparam Type The type of the lvalue
+	 * @param offset The byte offset to read from
+	 * @param buffer The lvalue
+	 * @return std::size_t The amount of lvalue read, 1 or 0 */
+	template<typename Type> typename std::enable_if<
+		is_flat<Type>::value && !std::is_array<Type>::value && !is_contiguous_leaf<Type>::value && !std::is_const<Type>::value, 
+	std::size_t>::type	read_at(const std::uint64_t offset, Type& buffer) { return _read_at(offset, (char*)&buffer, sizeof(Type)) / sizeof(Type); }
+	std::size_t			read_at(const std::uint64_t offset, iIOable& buffer) {
+		auto data = gio_buffer_pool::local().acquire(buffer.ObjectByteSize());
+		auto bytesread = _read_at(offset, data.get(), buffer.ObjectByteSize());
+		buffer.fromBytes(data.get());
+		return bytesread / buffer.ObjectByteSize();
+	}
+
+	/** @brief Reads size amount of objects from offset into pointer buffer
+	 * SUPPORTS: Any pointer to types that can be sent as raw bytes
+	 * @tparam Type The element type
+	 * @param offset The byte offset to read from
+	 * @param buffer The pointer buffer, preallocated
+	 * @param size The amount of objects to read
+	 * @return std::size_t The amount of Type objects read */
+	template<typename Type> typename std::enable_if<
+		is_flat<Type>::value && !std::is_const<Type>::value, 
+	std::size_t>::type	read_at(const std::uint64_t offset, Type* buffer, const std::size_t size) { return _read_at(offset, (char*)buffer, size * sizeof(Type)) / sizeof(Type); }
+
+	/** @brief Reads a fixed size std::array from offset in a single transfer
+	 * @tparam Type The element type
+	 * @tparam size The size of the array
+	 * @param offset The byte offset to read from
+	 * @param Container The array to read into
+	 * @return std::size_t The amount of Type elements read */
+	template<typename Type, std::size_t size> typename std::enable_if<
+		is_flat<Type>::value, 
+	std::size_t>::type	read_at(const std::uint64_t offset, std::array<Type, size>& Container) { return read_at(offset, Container.data(), size); }
+
+	/** @brief Appends length elements read from offset to a vector or string in a single transfer
+	 * SUPPORTS: std::vector and std::basic_string of types that can be sent as raw bytes
+	 * @tparam CT The container type
+	 * @param offset The byte offset to read from
+	 * @param Container The container to append to
+	 * @param length The amount of CT's type to read
+	 * @return std::size_t The amount of CT's type read */
+	template<typename CT> typename std::enable_if<
+		is_contiguous_leaf<CT>::value && !is_flat<CT>::value, 
+	std::size_t>::type	read_at(const std::uint64_t offset, CT& Container, const std::size_t length) {
+		const std::size_t old_size = Container.size();
+		Container.resize(old_size + length);
+		std::size_t n = read_at(offset, &Container[old_size], length);
+		Container.resize(old_size + n);
+		return n;
+	}
+
+#ifdef __cpp_lib_span
+	/** @brief Writes the elements referenced by a span at offset in a single transfer
+	 * @tparam Type The element type
+	 * @tparam Extent The extent of the span
+	 * @param offset The byte offset to write at
+	 * @param view The span to write
+	 * @return std::size_t The amount of Type elements written */
+	template<typename Type, std::size_t Extent> typename std::enable_if<
+		is_flat<typename std::remove_cv<Type>::type>::value, 
+	std::size_t>::type	write_at(const std::uint64_t offset, std::span<Type, Extent> view) { return _write_at(offset, (const char*)view.data(), view.size_bytes()) / sizeof(Type); }
+
+	/** @brief Reads from offset into the preallocated memory referenced by a span in a single transfer
+	 * @tparam Type The element type
+	 * @tparam Extent The extent of the span
+	 * @param offset The byte offset to read from
+	 * @param buffer The span to read into
+	 * @return std::size_t The amount of Type elements read */
+	template<typename Type, std::size_t Extent> typename std::enable_if<
+		!std::is_const<Type>::value && is_flat<Type>::value, 
+	std::size_t>::type	read_at(const std::uint64_t offset, std::span<Type, Extent> buffer) { return _read_at(offset, (char*)buffer.data(), buffer.size_bytes()) / sizeof(Type); }
+#endif
+
+	//? ======== Record readers ========>>==========================================================================================
+
+	/** @brief Input range over the records of the interface, yielding string_views into a reusable read-ahead buffer
+	 * A record excludes its terminator, the last record does not need to be terminated.
+	 * A yielded string_view is valid until the iterator is incremented.
+	 * Data read ahead of the current record stays buffered and is returned first by any following read.
+	 */
+	class record_range {
+		iGIO& _igio;
+		std::string _terminator;
+	public:
+		class iterator {
+			record_range* _range = nullptr;
+			std::string_view _record;
+		public:
+			using iterator_category = std::input_iterator_tag;
+			using value_type		= std::string_view;
+			using difference_type	= std::ptrdiff_t;
+			using pointer			= const std::string_view*;
+			using reference			= const std::string_view&;
+
+			iterator() {}
+			explicit iterator(record_range* range) : _range(range) { ++(*this); }
+
+			reference operator*()  const { return _record; }
+			pointer   operator->() const { return &_record; }
+			iterator& operator++() {
+				if(!_range->_igio._next_record(_range->_terminator, _record))
+					_range = nullptr;
+				return *this;
+			}
+			bool operator==(const iterator& other) const { return _range == other._range; }
+			bool operator!=(const iterator& other) const { return _range != other._range; }
+		};
+
+		record_range(iGIO& igio, std::string_view terminator) : _igio(igio), _terminator(terminator) {}
+		iterator begin() { return iterator(this); }
+		iterator end()   { return iterator(); }
+	};
+
+	/** @brief Reads the interface record by record without allocating per record
+	 * EXAMPLE: for(std::string_view record : file.records(";")) 
+	 * @param terminator The byte sequence that ends a record
+	 * @return record_range Input range of string_views, each valid until the next increment */
+	record_range		records(std::string_view terminator) { return record_range(*this, terminator); }
+
+	/** @brief Reads the interface line by line without allocating per line, lines are terminated by the LineEnder
+	 * EXAMPLE: for(std::string_view line : file.lines()) 
+	 * @return record_range Input range of string_views, each valid until the next increment */
+	record_range		lines() { return records(LineEnder); }
+
+	//? ======== Text R/W wrappers ========>>==========================================================================================
+
+	/** @brief Reads a number written as text from the interface, parsing it straight from the read-ahead buffer
+	 * Skips the TextWhitespace and delimiter characters in front of the number, without using locales or intermediate strings.
+	 * Throws IOfailure if the text is not a valid number.
+	 * SUPPORTS: Any arithmetic type excluding bool
+	 * @tparam Type The number type
+	 * @param value The number to read into
+	 * @param delimiters Characters separating values next to the TextWhitespace, e.g. "," for comma separated values
+	 * @return std::size_t The amount of numbers read, 1 or 0 */
+	template<typename Type> typename std::enable_if<
+		std::is_arithmetic<Type>::value && !std::is_same<Type, bool>::value,
+	std::size_t>::type	read_text(Type& value, std::string_view delimiters = "") {
+		std::string_view token;
+		if(!_next_token(_separators(delimiters), token))
+			return 0;
+		_parse_text(token, value);
+		return 1;
+	}
+
+	/** @brief Reads numbers written as text into a container until no data available or length is reached
+	 * Throws IOfailure if the text is not a valid number.
+	 * SUPPORTS: Any container of arithmetic types that supports the .push_back() method
+	 * @tparam CT The container type
+	 * @param Container Container to read into
+	 * @param delimiters Characters separating values next to the TextWhitespace, e.g. "," for comma separated values
+	 * @param maxlength Maximum amount of CT's type to read
+	 * @return std::size_t The amount of CT's type read */
+	template<typename CT> typename std::enable_if<
+		is_container<CT>::value && has_pushback<CT>::value && std::is_arithmetic<CElemType<CT>>::value && !std::is_same<CElemType<CT>, bool>::value,
+	std::size_t>::type	read_text(CT& Container, std::string_view delimiters = "", std::size_t maxlength = 0) {
+		maxlength = maxlength ? maxlength : std::numeric_limits<std::size_t>::max();
+		const separator_table separators = _separators(delimiters);
+		std::string_view token;
+		std::size_t i = 0;
+		for(; i < maxlength && _next_token(separators, token); i++){
+			CElemType<CT> value;
+			_parse_text(token, value);
+			Container.push_back(value);
+		}
+		return i;
+	}
+
+	/** @brief Writes a number as text to the interface, formatted with std::to_chars into a reusable scratch buffer
+	 * Integers are written in decimal, floating point numbers in their shortest round trip representation
+	 * SUPPORTS: Any arithmetic type excluding bool and character types
+	 * @tparam Type The number type
+	 * @param value The number to write
+	 * @return std::size_t The amount of numbers written, 1 or 0 */
+	template<typename Type> typename std::enable_if<
+		is_text_number<Type>::value,
+	std::size_t>::type	write_text(const Type value) {
+		_format_text(value);
+		_flush_text();
+		return 1;
+	}
+
+	/** @brief Writes a range of numbers as text to the interface, joined by a separator
+	 * The range is formatted into the scratch buffer and written in ChunkBytes sized transfers
+	 * SUPPORTS: Any iterator type of arithmetic types excluding bool and character types
+	 * @tparam InputIt The iterator type
+	 * @param first Iterator pointing to the start of range
+	 * @param last  Iterator pointing to the end of range
+	 * @param separator The text to insert between numbers
+	 * @return std::size_t The amount of numbers written */
+	template<typename InputIt> typename std::enable_if<
+		is_iterator<InputIt>::value && is_text_number<iterType<InputIt>>::value,
+	std::size_t>::type	write_text(InputIt first, InputIt last, std::string_view separator = " ") {
+		std::size_t i = 0;
+		for(; first!=last; ++first, i++){
+			if(i)
+				_append_text(separator);
+			_format_text(*first);
+			if(_tbuf_used >= ChunkBytes)
+				_flush_text();
+		}
+		_flush_text();
+		return i;
+	}
+
+	/** @brief Writes a container of numbers as text to the interface, joined by a separator
+	 * SUPPORTS: Any container of arithmetic types excluding bool and character types
+	 * @tparam CT The container type
+	 * @param Container The container to write
+	 * @param separator The text to insert between numbers
+	 * @return std::size_t The amount of numbers written */
+	template<typename CT> typename std::enable_if<
+		is_text_number_container<CT>::value,
+	std::size_t>::type	write_text(const CT& Container, std::string_view separator = " ") {
+		return write_text(Container.begin(), Container.end(), separator);
+	}
+
+	//? ======== Varint R/W wrappers ========>>==========================================================================================
+
+	/** @brief Writes a range of integers as LEB128 varints, formatted into the scratch buffer and written in ChunkBytes sized transfers
+	 * The values are preceded by their count and the delta flag, so read_varint() needs no arguments to read them back.
+	 * Signed values are zigzag coded. With delta every value is stored as the zigzag coded difference to the one before,
+	 * which keeps sorted or slowly changing values like timestamps and IDs at one or two bytes each.
+	 * SUPPORTS: Any forward iterator type of integral types excluding bool
+	 * @tparam InputIt The iterator type
+	 * @param first Iterator pointing to the start of range
+	 * @param last  Iterator pointing to the end of range
+	 * @param delta Whether to store differences to the previous value
+	 * @return std::size_t The amount of integers written */
+	template<typename InputIt> typename std::enable_if<
+		is_iterator<InputIt>::value && std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>::value
+		&& std::is_integral<iterType<InputIt>>::value && !std::is_same<iterType<InputIt>, bool>::value,
+	std::size_t>::type	write_varint(InputIt first, InputIt last, const bool delta = false) {
+		using Type = typename std::remove_cv<iterType<InputIt>>::type;
+		const std::uint64_t count = (std::uint64_t)std::distance(first, last);
+		_tbuf_reserve(gio_varint::max_bytes);
+		_tbuf_used += gio_varint::encode(count << 1 | delta, _tbuf.get() + _tbuf_used);
+		Type previous = 0;
+		for(; first!=last; ++first){
+			_tbuf_reserve(gio_varint::max_bytes);
+			_tbuf_used += gio_varint::encode(gio_varint::pack<Type>(*first, previous, delta), _tbuf.get() + _tbuf_used);
+			if(_tbuf_used >= ChunkBytes)
+				_flush_text();
+		}
+		_flush_text();
+		return (std::size_t)count;
+	}
+
+	/** @brief Writes a container of integers as LEB128 varints, see write_varint(first, last, delta)
+	 * SUPPORTS: Any container of integral types excluding bool
+	 * @tparam CT The container type
+	 * @param Container The container to write
+	 * @param delta Whether to store differences to the previous value
+	 * @return std::size_t The amount of integers written */
+	template<typename CT> typename std::enable_if<
+		is_container<CT>::value && std::is_integral<CElemType<CT>>::value && !std::is_same<CElemType<CT>, bool>::value,
+	std::size_t>::type	write_varint(const CT& Container, const bool delta = false) {
+		return write_varint(Container.begin(), Container.end(), delta);
+	}
+
+	/** @brief Reads integers written by write_varint() into a container, decoding them straight from the read-ahead buffer
+	 * The element type must match the one written. Throws IOfailure if a varint is longer than 10 bytes.
+	 * SUPPORTS: Any container of integral types excluding bool that supports the .push_back() method
+	 * @tparam CT The container type
+	 * @param Container Container to read into
+	 * @return std::size_t The amount of integers read, fewer than written if no more data is available */
+	template<typename CT> typename std::enable_if<
+		is_container<CT>::value && has_pushback<CT>::value && std::is_integral<CElemType<CT>>::value && !std::is_same<CElemType<CT>, bool>::value,
+	std::size_t>::type	read_varint(CT& Container) {
+		using Type = CElemType<CT>;
+		std::uint64_t header;
+		if(!_next_varints(&header, 1))
+			return 0;
+		const std::uint64_t count = header >> 1;
+		const bool delta = header & 1;
+		Type previous = 0;
+		std::uint64_t decoded[256];
+		std::uint64_t i = 0;
+		while(i < count){
+			const std::size_t n = _next_varints(decoded, (std::size_t)std::min<std::uint64_t>(count - i, 256));
+			if(!n)
+				break;
+			for(std::size_t k = 0; k < n; k++)
+				Container.push_back(gio_varint::unpack<Type>(decoded[k], previous, delta));
+			i += n;
+		}
+		return (std::size_t)i;
+	}
+
+	//? ======== Columnar R/W wrappers ========>>==========================================================================================
+
+	/** @brief Writes a container of structs as columns, every listed field of all rows stored contiguously
+	 * The block starts with the row count, the column count and the byte size of every column's field, followed by the columns in the listed order.
+	 * Columns of one field compress much better than interleaved rows, and readers can fetch only the columns they need.
+	 * SUPPORTS: Any container of structs, with pointers to data members that can be sent as raw bytes
+	 * @tparam CT The container type
+	 * @tparam Members The data member pointer types
+	 * @param Container The container to write
+	 * @param members The data members stored as columns, e.g. &record::id, &record::time
+	 * @return std::size_t The amount of rows written */
+	template<typename CT, typename... Members> typename std::enable_if<
+		is_container<CT>::value && !is_container_adapter<CT>::value && sizeof...(Members) != 0 && (is_column<Members, CElemType<CT>>::value && ...),
+	std::size_t>::type	write_columns(const CT& Container, Members... members) {
+		const std::uint64_t rows = (std::uint64_t)std::distance(Container.begin(), Container.end());
+		const std::uint32_t columns = (std::uint32_t)sizeof...(Members);
+		const std::uint32_t sizes[] = {(std::uint32_t)sizeof((*Container.begin()).*members)...};
+		std::uint64_t bytes = 0;
+		for(std::uint32_t size : sizes)
+			bytes += rows * size;
+		_reserve(sizeof(rows) + sizeof(columns) + sizeof(sizes) + bytes);
+		_write((const char*)&rows, sizeof(rows));
+		_write((const char*)&columns, sizeof(columns));
+		_write((const char*)sizes, sizeof(sizes));
+		(_write_column(Container, rows, members), ...);
+		return (std::size_t)rows;
+	}
+
+	/** @brief Reads a block written by write_columns() back into rows, with projection
+	 * The container is resized to the stored row count. Every argument reads the column at its position into a data member,
+	 * nullptr skips a column and columns after the last argument are skipped, fields of skipped columns keep their values.
+	 * Skipped columns are read and discarded, use read_columns_at() to not read them at all.
+	 * Throws IOfailure if the data ends early or a field's size differs from its stored column.
+	 * SUPPORTS: Any container of structs that supports the .resize() method, with pointers to data members that can be sent as raw bytes
+	 * @tparam CT The container type
+	 * @tparam Members The data member pointer types or std::nullptr_t
+	 * @param Container Container to read into
+	 * @param members The data members to read the columns into, e.g. nullptr, &record::time to read the second column only
+	 * @return std::size_t The amount of rows read */
+	template<typename CT, typename... Members> typename std::enable_if<
+		is_container<CT>::value && has_resize<CT>::value && (is_column_or_skip<Members, CElemType<CT>>::value && ...),
+	std::size_t>::type	read_columns(CT& Container, Members... members) {
+		std::unique_ptr<char[]> discard;
+		auto reader = [&](char* buffer, const std::uint64_t length){
+			if(!buffer && length && !discard)
+				discard = std::make_unique<char[]>(ChunkBytes);
+			for(std::uint64_t n = 0; n < length;){
+				const std::size_t k = buffer ? (std::size_t)(length - n) : (std::size_t)std::min<std::uint64_t>(length - n, ChunkBytes);
+				const std::size_t r = buffer ? _read(buffer + n, k) : _read(discard.get(), k);
+				if(!r)
+					throw IOfailure("Error reading: columns end after " + std::to_string(n) + " of " + std::to_string(length) + " bytes");
+				n += r;
+			}
+		};
+		return _read_columns(reader, Container, members...);
+	}
+
+	/** @brief Reads a block written by write_columns() at offset, reading only the bytes of the requested columns
+	 * Has the projection of read_columns(), skipped columns are never read. Does not use or move the read position,
+	 * see the positional functions. Throws IOfailure if the interface does not support positional access.
+	 * SUPPORTS: Any container of structs that supports the .resize() method, with pointers to data members that can be sent as raw bytes
+	 * @tparam CT The container type
+	 * @tparam Members The data member pointer types or std::nullptr_t
+	 * @param offset The byte offset the block starts at
+	 * @param Container Container to read into
+	 * @param members The data members to read the columns into, nullptr skips a column
+	 * @return std::size_t The amount of rows read */
+	template<typename CT, typename... Members> typename std::enable_if<
+		is_container<CT>::value && has_resize<CT>::value && (is_column_or_skip<Members, CElemType<CT>>::value && ...),
+	std::size_t>::type	read_columns_at(std::uint64_t offset, CT& Container, Members... members) {
+		auto reader = [&](char* buffer, const std::uint64_t length){
+			if(buffer && _read_at(offset, buffer, (std::size_t)length) != length)
+				throw IOfailure("Error reading: columns end before offset " + std::to_string(offset + length));
+			offset += length;
+		};
+		return _read_columns(reader, Container, members...);
+	}
+
+	//? ======== Run length R/W wrappers ========>>==========================================================================================
+
+	/** @brief Writes elements run length or sparse coded, for arrays that are mostly zeros or long runs of one value
+	 * The elements are split into blocks of about ChunkBytes. A fast scan of every block measures its zero and repeat density,
+	 * the block is then stored as runs, as its nonzero elements with their positions, or raw when neither is smaller.
+	 * Raw blocks are written straight from data. The element count and size are stored in front of the blocks.
+	 * SUPPORTS: Pointers to types that can be sent as raw bytes
+	 * @tparam Type The element type
+	 * @param data The elements to write
+	 * @param count The amount of elements
+	 * @return std::size_t The amount of elements written */
+	template<typename Type> typename std::enable_if<
+		is_flat<Type>::value,
+	std::size_t>::type	write_rle(const Type* data, const std::size_t count) {
+		_write_rle((const char*)data, count, sizeof(Type));
+		return count;
+	}
+	/** @brief Writes an array run length or sparse coded, see write_rle(data, count)
+	 * SUPPORTS: Arrays of types that can be sent as raw bytes, N dimensional arrays are coded by their innermost rows */
+	template<typename Type, std::size_t N> typename std::enable_if<
+		is_flat<Type>::value,
+	std::size_t>::type	write_rle(const Type (&data)[N]) {
+		return write_rle(data, N);
+	}
+	/** @brief Writes a contiguous container run length or sparse coded, see write_rle(data, count)
+	 * SUPPORTS: std::vector and std::array of types that can be sent as raw bytes */
+	template<typename CT> typename std::enable_if<
+		is_contiguous_container<typename std::remove_cv<CT>::type>::value,
+	std::size_t>::type	write_rle(const CT& Container) {
+		return write_rle(Container.data(), Container.size());
+	}
+
+	/** @brief Reads elements written by write_rle(), filling runs and zeroed blocks with memset like fills
+	 * Throws IOfailure if more than count elements were written, the element size differs or the data is corrupt.
+	 * SUPPORTS: Pointers to types that can be sent as raw bytes
+	 * @tparam Type The element type
+	 * @param data Room for count elements
+	 * @param count The maximum amount of elements
+	 * @return std::size_t The amount of elements read */
+	template<typename Type> typename std::enable_if<
+		is_flat<Type>::value,
+	std::size_t>::type	read_rle(Type* data, const std::size_t count) {
+		const std::uint64_t stored = _read_rle_count(sizeof(Type));
+		if(stored > count)
+			throw IOfailure("Error reading: " + std::to_string(stored) + " run length coded elements read into room for " + std::to_string(count));
+		_read_rle([data](std::uint64_t filled, std::size_t){ return (char*)(data + filled); }, stored, sizeof(Type));
+		return (std::size_t)stored;
+	}
+	/** @brief Reads an array written by write_rle(), see read_rle(data, count)
+	 * SUPPORTS: Arrays of types that can be sent as raw bytes */
+	template<typename Type, std::size_t N> typename std::enable_if<
+		is_flat<Type>::value,
+	std::size_t>::type	read_rle(Type (&data)[N]) {
+		return read_rle(data, N);
+	}
+	/** @brief Reads elements written by write_rle() into a contiguous container, a std::vector is resized to the stored count
+	 * A std::vector grows block by block as the blocks are read, so a corrupt count does not allocate more than the data holds
+	 * SUPPORTS: std::vector and std::array of types that can be sent as raw bytes */
+	template<typename CT> typename std::enable_if<
+		is_contiguous_container<CT>::value,
+	std::size_t>::type	read_rle(CT& Container) {
+		using Type = CElemType<CT>;
+		if constexpr(has_resize<CT>::value){
+			const std::uint64_t stored = _read_rle_count(sizeof(Type));
+			Container.clear();
+			_read_rle([&Container](std::uint64_t filled, std::size_t n){
+				Container.resize((std::size_t)filled + n);
+				return (char*)(Container.data() + filled);
+			}, stored, sizeof(Type));
+			return (std::size_t)stored;
+		}
+		else
+			return read_rle(Container.data(), Container.size());
+	}
+
 	//? ======== Stream R/W wrappers ========>>==========================================================================================
 
-	/** @brief Writes from an istream until end of line.
-	 * Stream will be split based on whitespaces into a buffer of strings.
+	/** @brief Copies an istream to the interface
+	 * The stream's buffer is read in ChunkBytes sized chunks, every chunk is written with a single transfer.
+	 * No formatting or tokenizing is applied, use write(stream, seperator) to split the stream on whitespaces.
+	 * SUPPORTS: Any input stream
+	 * @tparam IsT The InputStream Type
+	 * @param stream The stream to write from, eofbit is set once the stream is exhausted
+	 * @return std::size_t The number of characters written */
+	template<typename IsT> typename std::enable_if<
+		std::is_base_of<std::basic_istream<typename IsT::char_type, typename IsT::traits_type>, IsT>::value,
+	std::size_t>::type	write(IsT& stream) {
+		using CharT = typename IsT::char_type;
+		auto* streambuf = stream.rdbuf();
+		if(!streambuf){
+			stream.setstate(std::ios_base::badbit);
+			return 0;
+		}
+		const std::size_t chunk_length = std::max<std::size_t>(ChunkBytes / sizeof(CharT), 1);
+		_tbuf_reserve(chunk_length * sizeof(CharT));
+		CharT* chunk = (CharT*)_tbuf.get();
+		std::size_t written = 0;
+		for(std::streamsize n; (n = streambuf->sgetn(chunk, chunk_length)) > 0;)
+			written += _write((const char*)chunk, n * sizeof(CharT)) / sizeof(CharT);
+		stream.setstate(std::ios_base::eofbit);
+		return written;
+	}
+
+	/** @brief Writes an istream to the interface split on whitespaces, inserting a seperator between the parts.
 	 * EXAMPLE: The stringstream "Hello world!" will be extracted into two 
-	 * seperate buffers containing "Hello" and "world!", which will individually 
-	 * be sent over the interface. To add the whitespace set the seperator to " "
-	 * SUPPORTS: Any stream that supports stream extraction to IT
-	 * @tparam IT The InputType
+	 * seperate buffers containing "Hello" and "world!", which will be sent over 
+	 * the interface as "Hello", seperator, "world!". To keep the whitespace set the seperator to " "
+	 * Extraction continues over line ends until the stream is exhausted.
+	 * SUPPORTS: Any stream that supports stream extraction to std::string
 	 * @tparam IsT The InputStream Type
 	 * @param stream The stream to write from
 	 * @param seperator The seperator to insert between writes, 
-	 * 		e.g. "hello world" would normally write as "hello", "world" with a seperator it would write as: "hello", sep, "world"
-	 * @return std::size_t The number of IT elements written */
-	template<typename IsT> constexpr typename std::enable_if<
+	 * 		e.g. "hello world" is written as "hello", seperator, "world"
+	 * @return std::size_t The number of std::string parts written */
+	template<typename IsT> typename std::enable_if<
 		std::is_base_of<std::ios_base, IsT>::value && can_extract_to<IsT, std::string>::value,
-	std::size_t>::type	write(IsT& stream, std::string seperator = "") {
-		// boolean to keep track for if the stream is cin, and it has already been read
-		// Needed as otherwise reading will continue indefinitely
-		bool readcin = false;
+	std::size_t>::type	write(IsT& stream, std::string_view seperator) {
 		std::size_t written_ITs = 0;
-		std::string line;
-		std::getline(stream, line);
-		std::istringstream iss(line);
-		while(!iss.eof() && !iss.fail() && !readcin){ // check for end of stream
-			std::string buffer;
-			iss >> buffer;
+		for(std::string buffer; stream >> buffer; written_ITs++){
 			if(written_ITs)
-				write(seperator);
-			write(buffer);
-			written_ITs++;
-		};
+				_append_text(seperator);
+			_append_text(buffer);
+			if(_tbuf_used >= ChunkBytes)
+				_flush_text();
+		}
+		_flush_text();
 		return written_ITs;
 	}
 
@@ -899,14 +2304,39 @@ public:
 	 */
 	template<typename Type>
 	iGIO& operator<<(Type&& _t){
-		write(_t);
+		_insert(_t);
 		return *this;
 	}
 
+	/** @brief Overloaded operator<< for interface manipulators like text and binary
+	 * @param manip An interface manipulator
+	 * @return iGIO& Reference to the interface
+	 */
+	iGIO& operator<<(iGIO&(*manip)(iGIO&)){
+		return manip(*this);
+	}
+
+	/** @brief Manipulator switching operator<< and operator>> to text mode
+	 * In text mode numbers and containers of numbers are written with write_text() and read with read_text(), other types are unaffected
+	 * Containers are read with read_text() when they support push_back(), the numbers are appended until no data is available
+	 * EXAMPLE: file << iGIO::text << 42 << std::endl;
+	 */
+	static iGIO& text(iGIO& ref){
+		ref._text_mode = true;
+		return ref;
+	}
+
+	/** @brief Manipulator switching operator<< and operator>> back to binary mode, the default
+	 */
+	static iGIO& binary(iGIO& ref){
+		ref._text_mode = false;
+		return ref;
+	}
+
 	/** @brief Overloaded operator<< for stream manipulators like endl and flush
 	 * SUPPORTS: endl() and flush() stream manipulators
 	 * std::endl calls the custom endl() function, which by default writes the LineEnder (by default \\n) and flushing the interface through the custom flush() function
-	 * std::flush calls the custom flush() function, which by default does nothing
+	 * std::flush calls the custom flush() function, which calls the interface's iFlush()
 	 * Only implemented for code readability and concistency
 	 * @param var a templated ostream io manipulator like std::endl
 	 * @return iGIO& Reference to the interface
@@ -919,14 +2349,16 @@ public:
 		return *this;
 	}
 
-	/** @brief Read interface to stream
-	 * SUPPORTS: any stream supported by a read() function
+	/** @brief Read interface to stream until no data is available
+	 * The interface is read in ChunkBytes sized chunks, every chunk is written to the stream at once
 	 * @param os the stream to read to
 	 * @param _igio the interface to read from
 	 * @return std::ostream& Reference to the stream
 	 */
 	friend std::ostream& operator<<(std::ostream& os, iGIO& _igio){
-		_igio.read(os);
+		_igio._tbuf_reserve(_igio.ChunkBytes);
+		for(std::size_t n; os.good() && (n = _igio._read(_igio._tbuf.get(), _igio.ChunkBytes));)
+			os.write(_igio._tbuf.get(), n);
 		return os;
 	}
 
@@ -938,7 +2370,40 @@ public:
 	 */
 	template<typename Type>
 	iGIO& operator>>(Type& _t){
-		read(_t);
+		_extract(_t);
 		return *this;
 	}
+
+private:
+	template<typename Type> typename std::enable_if<
+		is_text_number<typename std::remove_cv<Type>::type>::value || is_text_number_container<typename std::remove_cv<Type>::type>::value,
+	void>::type _insert(Type& _t) { 
+		if(_text_mode)
+			write_text(_t);
+		else
+			write(_t);
+	}
+	template<typename Type> typename std::enable_if<
+		!is_text_number<typename std::remove_cv<Type>::type>::value && !is_text_number_container<typename std::remove_cv<Type>::type>::value,
+	void>::type _insert(Type& _t) { write(_t); }
+
+	template<typename Type> typename std::enable_if<
+		is_text_number<Type>::value,
+	void>::type _extract(Type& _t) {
+		if(_text_mode)
+			read_text(_t);
+		else
+			read(_t);
+	}
+	template<typename Type> typename std::enable_if<
+		is_text_number_container<Type>::value && has_pushback<Type>::value,
+	void>::type _extract(Type& _t) {
+		if(_text_mode)
+			read_text(_t);
+		else
+			read(_t);
+	}
+	template<typename Type> typename std::enable_if<
+		!is_text_number<Type>::value && !(is_text_number_container<Type>::value && has_pushback<Type>::value),
+	void>::type _extract(Type& _t) { read(_t); }
 };
\ No newline at end of file
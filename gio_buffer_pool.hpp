@@ -0,0 +1,178 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+/**
+ * @brief Size class pool recycling the temporary staging buffers of the read and write functions
+ * Buffers are rounded up to a power of two size class and returned to a free list of that class when released.
+ * Buffers larger than the largest pooled size are allocated and freed directly, free buffers are kept up to the retained cap.
+ * Every thread has its own pool, see local(), so acquiring and releasing takes no locks.
+ * A buffer must be released on the thread that acquired it.
+ */
+class gio_buffer_pool {
+public:
+	/**
+	 * @brief Counters of a pool, all sizes in bytes
+	 */
+	struct stats {
+		std::size_t in_use = 0;			// bytes of the buffers currently acquired
+		std::size_t peak = 0;			// highest in_use since creation or reset_peak()
+		std::size_t retained = 0;		// bytes of the free buffers kept for reuse
+		std::size_t allocations = 0;	// buffers allocated from the heap
+		std::size_t reuses = 0;			// buffers taken from a free list
+	};
+
+	/**
+	 * @brief An acquired buffer, released to its pool when destroyed
+	 */
+	class buffer {
+		friend class gio_buffer_pool;
+		gio_buffer_pool* _pool = nullptr;
+		char* _data = nullptr;
+		std::size_t _capacity = 0;
+
+		buffer(gio_buffer_pool* pool, char* data, std::size_t capacity) : _pool(pool), _data(data), _capacity(capacity) {}
+	public:
+		buffer() = default;
+		buffer(buffer&& other) noexcept : _pool(other._pool), _data(other._data), _capacity(other._capacity) {
+			other._pool = nullptr;
+			other._data = nullptr;
+		}
+		buffer& operator=(buffer&& other) noexcept {
+			std::swap(_pool, other._pool);
+			std::swap(_data, other._data);
+			std::swap(_capacity, other._capacity);
+			return *this;
+		}
+		~buffer(){
+			if(_pool)
+				_pool->_release(_data, _capacity);
+		}
+		char* get() const {
+			return _data;
+		}
+		std::size_t capacity() const {
+			return _capacity;
+		}
+	};
+private:
+	static constexpr std::size_t min_class_bits = 6; // 64 bytes
+	static constexpr std::size_t class_count = 40;
+
+	std::vector<char*> _free[class_count];
+	std::size_t _max_retained = 16 * 1024 * 1024;
+	std::size_t _max_pooled = 4 * 1024 * 1024;
+	stats _stats;
+
+	static std::size_t _class_of(const std::size_t size){
+		std::size_t bits = min_class_bits;
+		while((std::size_t(1) << bits) < size)
+			bits++;
+		return bits - min_class_bits;
+	}
+	static std::size_t _class_size(const std::size_t size_class){
+		return std::size_t(1) << (size_class + min_class_bits);
+	}
+
+	void _release(char* data, const std::size_t capacity){
+		_stats.in_use -= capacity;
+		// buffers acquired unpooled before the limits were raised are not a class size and must not be handed out as one
+		if(capacity > _max_pooled || capacity != _class_size(_class_of(capacity)) || _stats.retained + capacity > _max_retained){
+			delete[] data;
+			return;
+		}
+		_free[_class_of(capacity)].push_back(data);
+		_stats.retained += capacity;
+	}
+public:
+	gio_buffer_pool() = default;
+	gio_buffer_pool(const gio_buffer_pool&) = delete;
+	gio_buffer_pool& operator=(const gio_buffer_pool&) = delete;
+	~gio_buffer_pool(){
+		trim();
+	}
+
+	/**
+	 * @brief The pool of the calling thread
+	 */
+	static gio_buffer_pool& local(){
+		thread_local gio_buffer_pool pool;
+		return pool;
+	}
+
+	/**
+	 * @brief Acquires a buffer of at least size bytes, reusing a free buffer of the same size class when available
+	 * @param size The amount of bytes needed
+	 * @return buffer The buffer, released when destroyed
+	 */
+	buffer acquire(const std::size_t size){
+		char* data = nullptr;
+		std::size_t capacity = size;
+		if(size <= _max_pooled){
+			const std::size_t size_class = _class_of(size);
+			capacity = _class_size(size_class);
+			if(!_free[size_class].empty()){
+				data = _free[size_class].back();
+				_free[size_class].pop_back();
+				_stats.retained -= capacity;
+				_stats.reuses++;
+			}
+		}
+		if(!data){
+			data = new char[capacity];
+			_stats.allocations++;
+		}
+		_stats.in_use += capacity;
+		_stats.peak = std::max(_stats.peak, _stats.in_use);
+		return buffer(this, data, capacity);
+	}
+
+	/**
+	 * @brief Sets the caps of the pool, free buffers above the new retained cap are freed
+	 * @param max_retained The maximum amount of bytes kept in free buffers
+	 * @param max_pooled The largest buffer size that is pooled, larger buffers are allocated and freed directly
+	 */
+	void set_limits(const std::size_t max_retained, const std::size_t max_pooled){
+		_max_retained = max_retained;
+		_max_pooled = max_pooled;
+		for(std::size_t size_class = class_count; size_class-- > 0 && _stats.retained > _max_retained; )
+			for(; !_free[size_class].empty() && _stats.retained > _max_retained; _free[size_class].pop_back()){
+				delete[] _free[size_class].back();
+				_stats.retained -= _class_size(size_class);
+			}
+		for(std::size_t size_class = 0; size_class < class_count; size_class++)
+			if(_class_size(size_class) > _max_pooled)
+				for(; !_free[size_class].empty(); _free[size_class].pop_back()){
+					delete[] _free[size_class].back();
+					_stats.retained -= _class_size(size_class);
+				}
+	}
+
+	/**
+	 * @brief Frees all free buffers
+	 */
+	void trim(){
+		for(std::size_t size_class = 0; size_class < class_count; size_class++){
+			for(char* data : _free[size_class])
+				delete[] data;
+			_free[size_class].clear();
+		}
+		_stats.retained = 0;
+	}
+
+	/**
+	 * @brief Sets the peak to the bytes currently in use
+	 */
+	void reset_peak(){
+		_stats.peak = _stats.in_use;
+	}
+
+	/**
+	 * @brief The counters of the pool
+	 */
+	const stats& statistics() const {
+		return _stats;
+	}
+};
@@ -0,0 +1,512 @@
+#pragma once
+#include "GRWI.hpp"
+
+#include <vector>
+#include <array>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <random>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define GIO_CHACHA20_AVX2 1
+#endif
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define GIO_CHACHA20_SSE2 1
+#endif
+
+/**
+ * @brief Authenticated encryption filter using ChaCha20-Poly1305 (RFC 8439), see iGIO::add_filter()
+ * Written bytes are collected into blocks of block_size bytes, a block is encrypted when it is full or on flush().
+ * A stream starts with a random 8 byte salt, followed by blocks stored as a little endian std::uint32_t length,
+ * the ciphertext and a 16 byte tag. The nonce of a block is its index and the salt, the length is authenticated data,
+ * so modified, reordered or spliced blocks fail authentication. remove_filters() ends the stream with an authenticated
+ * empty block, a stream missing it was truncated, unless this filter is still writing it.
+ * Appending to an existing stream with a new filter starts a segment with its own salt after the end of the previous one,
+ * reads continue across segments. A whole segment removed from the end is not detected.
+ * Reads authenticate every block before decrypting it and throw IOfailure with the block's offset when it fails.
+ * ChaCha20 runs 8 blocks at a time with AVX2 or 4 with SSE2 when available, selected once at runtime.
+ */
+class gio_chacha20_filter : public gio_block_filter {
+public:
+	using key_type = std::array<std::uint8_t, 32>;
+private:
+	static constexpr std::size_t salt_size = 8;
+	static constexpr std::size_t header_size = 4;
+	static constexpr std::size_t tag_size = 16;
+	static constexpr std::size_t max_block_size = std::size_t(1) << 24;
+
+	key_type _key;
+	std::uint8_t _write_salt[salt_size];
+	std::uint8_t _read_salt[salt_size];
+	bool _write_started = false;
+	bool _read_started = false;
+	std::uint32_t _write_index = 0; // index of the next block written
+	std::uint32_t _read_index = 0;
+	bool _write_ended = false; // the end block was written by finish()
+	std::uint64_t _offset = 0; // offset in the underlying stream of the block being read
+
+	//? ======== ChaCha20 ========>>====
+
+	static std::uint32_t _rotate(const std::uint32_t v, const int n){
+		return (v << n) | (v >> (32 - n));
+	}
+
+	static void _state(const key_type& key, const std::uint8_t* nonce, std::uint32_t state[16]){
+		state[0] = 0x61707865; state[1] = 0x3320646e; state[2] = 0x79622d32; state[3] = 0x6b206574;
+		for(std::size_t i = 0; i < 8; i++)
+			state[4 + i] = get_u32(key.data() + 4 * i);
+		state[12] = 0;
+		for(std::size_t i = 0; i < 3; i++)
+			state[13 + i] = get_u32(nonce + 4 * i);
+	}
+
+	static void _block_scalar(const std::uint32_t state[16], const std::uint32_t counter, std::uint8_t out[64]){
+		std::uint32_t x[16];
+		std::memcpy(x, state, sizeof(x));
+		x[12] = counter;
+		auto quarter = [&x](const int a, const int b, const int c, const int d){
+			x[a] += x[b]; x[d] = _rotate(x[d] ^ x[a], 16);
+			x[c] += x[d]; x[b] = _rotate(x[b] ^ x[c], 12);
+			x[a] += x[b]; x[d] = _rotate(x[d] ^ x[a], 8);
+			x[c] += x[d]; x[b] = _rotate(x[b] ^ x[c], 7);
+		};
+		for(int round = 0; round < 10; round++){
+			quarter(0, 4, 8, 12); quarter(1, 5, 9, 13); quarter(2, 6, 10, 14); quarter(3, 7, 11, 15);
+			quarter(0, 5, 10, 15); quarter(1, 6, 11, 12); quarter(2, 7, 8, 13); quarter(3, 4, 9, 14);
+		}
+		for(std::size_t i = 0; i < 16; i++)
+			put_u32(out + 4 * i, x[i] + (i == 12 ? counter : state[i]));
+	}
+
+#ifdef GIO_CHACHA20_SSE2
+	static __m128i _rotl_sse2(const __m128i v, const int n){
+		return _mm_or_si128(_mm_slli_epi32(v, n), _mm_srli_epi32(v, 32 - n));
+	}
+	__attribute__((always_inline))
+	static inline void _quarter_sse2(__m128i& a, __m128i& b, __m128i& c, __m128i& d){
+		a = _mm_add_epi32(a, b); d = _rotl_sse2(_mm_xor_si128(d, a), 16);
+		c = _mm_add_epi32(c, d); b = _rotl_sse2(_mm_xor_si128(b, c), 12);
+		a = _mm_add_epi32(a, b); d = _rotl_sse2(_mm_xor_si128(d, a), 8);
+		c = _mm_add_epi32(c, d); b = _rotl_sse2(_mm_xor_si128(b, c), 7);
+	}
+	// xors 4 blocks of keystream into 256 bytes, every vector holds one word of the 4 blocks
+	static void _xor4_sse2(const std::uint32_t state[16], const std::uint32_t counter, const std::uint8_t* in, std::uint8_t* out){
+		__m128i x[16], initial[16];
+		#pragma GCC unroll 16
+		for(std::size_t i = 0; i < 16; i++)
+			initial[i] = _mm_set1_epi32((int)state[i]);
+		initial[12] = _mm_add_epi32(_mm_set1_epi32((int)counter), _mm_set_epi32(3, 2, 1, 0));
+		std::memcpy(x, initial, sizeof(x));
+		#pragma GCC unroll 16
+		for(int round = 0; round < 10; round++){
+			_quarter_sse2(x[0], x[4], x[8], x[12]); _quarter_sse2(x[1], x[5], x[9], x[13]);
+			_quarter_sse2(x[2], x[6], x[10], x[14]); _quarter_sse2(x[3], x[7], x[11], x[15]);
+			_quarter_sse2(x[0], x[5], x[10], x[15]); _quarter_sse2(x[1], x[6], x[11], x[12]);
+			_quarter_sse2(x[2], x[7], x[8], x[13]); _quarter_sse2(x[3], x[4], x[9], x[14]);
+		}
+		#pragma GCC unroll 16
+		for(std::size_t group = 0; group < 4; group++){ // transposes words 4 * group to 4 * group + 3 into the 4 blocks
+			__m128i* w = x + 4 * group;
+			#pragma GCC unroll 16
+			for(std::size_t i = 0; i < 4; i++)
+				w[i] = _mm_add_epi32(w[i], initial[4 * group + i]);
+			const __m128i t0 = _mm_unpacklo_epi32(w[0], w[1]), t1 = _mm_unpacklo_epi32(w[2], w[3]);
+			const __m128i t2 = _mm_unpackhi_epi32(w[0], w[1]), t3 = _mm_unpackhi_epi32(w[2], w[3]);
+			const __m128i blocks[4] = {_mm_unpacklo_epi64(t0, t1), _mm_unpackhi_epi64(t0, t1), _mm_unpacklo_epi64(t2, t3), _mm_unpackhi_epi64(t2, t3)};
+			#pragma GCC unroll 16
+			for(std::size_t b = 0; b < 4; b++){
+				const std::size_t at = 64 * b + 16 * group;
+				_mm_storeu_si128((__m128i*)(out + at), _mm_xor_si128(_mm_loadu_si128((const __m128i*)(in + at)), blocks[b]));
+			}
+		}
+	}
+#endif
+
+#ifdef GIO_CHACHA20_AVX2
+	__attribute__((target("avx2"), always_inline))
+	static inline void _quarter_avx2(__m256i& a, __m256i& b, __m256i& c, __m256i& d, const __m256i& rot16, const __m256i& rot8){
+		a = _mm256_add_epi32(a, b); d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot16);
+		c = _mm256_add_epi32(c, d); b = _mm256_xor_si256(b, c); b = _mm256_or_si256(_mm256_slli_epi32(b, 12), _mm256_srli_epi32(b, 20));
+		a = _mm256_add_epi32(a, b); d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot8);
+		c = _mm256_add_epi32(c, d); b = _mm256_xor_si256(b, c); b = _mm256_or_si256(_mm256_slli_epi32(b, 7), _mm256_srli_epi32(b, 25));
+	}
+	// xors 8 blocks of keystream into 512 bytes, the low lanes hold blocks 0 to 3 and the high lanes blocks 4 to 7
+	__attribute__((target("avx2")))
+	static void _xor8_avx2(const std::uint32_t state[16], const std::uint32_t counter, const std::uint8_t* in, std::uint8_t* out){
+		const __m256i rot16 = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13, 2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+		const __m256i rot8 = _mm256_setr_epi8(3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14, 3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14);
+		__m256i x[16], initial[16];
+		#pragma GCC unroll 16
+		for(std::size_t i = 0; i < 16; i++)
+			initial[i] = _mm256_set1_epi32((int)state[i]);
+		initial[12] = _mm256_add_epi32(_mm256_set1_epi32((int)counter), _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+		#pragma GCC unroll 16
+		for(std::size_t i = 0; i < 16; i++)
+			x[i] = initial[i];
+		#pragma GCC unroll 16
+		for(int round = 0; round < 10; round++){
+			_quarter_avx2(x[0], x[4], x[8], x[12], rot16, rot8); _quarter_avx2(x[1], x[5], x[9], x[13], rot16, rot8);
+			_quarter_avx2(x[2], x[6], x[10], x[14], rot16, rot8); _quarter_avx2(x[3], x[7], x[11], x[15], rot16, rot8);
+			_quarter_avx2(x[0], x[5], x[10], x[15], rot16, rot8); _quarter_avx2(x[1], x[6], x[11], x[12], rot16, rot8);
+			_quarter_avx2(x[2], x[7], x[8], x[13], rot16, rot8); _quarter_avx2(x[3], x[4], x[9], x[14], rot16, rot8);
+		}
+		__m256i words[4][4]; // [group][block], 16 bytes of block b in the low lane and of block b + 4 in the high lane
+		#pragma GCC unroll 16
+		for(std::size_t group = 0; group < 4; group++){
+			__m256i* w = x + 4 * group;
+			#pragma GCC unroll 16
+			for(std::size_t i = 0; i < 4; i++)
+				w[i] = _mm256_add_epi32(w[i], initial[4 * group + i]);
+			const __m256i t0 = _mm256_unpacklo_epi32(w[0], w[1]), t1 = _mm256_unpacklo_epi32(w[2], w[3]);
+			const __m256i t2 = _mm256_unpackhi_epi32(w[0], w[1]), t3 = _mm256_unpackhi_epi32(w[2], w[3]);
+			words[group][0] = _mm256_unpacklo_epi64(t0, t1);
+			words[group][1] = _mm256_unpackhi_epi64(t0, t1);
+			words[group][2] = _mm256_unpacklo_epi64(t2, t3);
+			words[group][3] = _mm256_unpackhi_epi64(t2, t3);
+		}
+		#pragma GCC unroll 16
+		for(std::size_t b = 0; b < 4; b++){
+			const __m256i parts[4] = {
+				_mm256_permute2x128_si256(words[0][b], words[1][b], 0x20), _mm256_permute2x128_si256(words[2][b], words[3][b], 0x20),
+				_mm256_permute2x128_si256(words[0][b], words[1][b], 0x31), _mm256_permute2x128_si256(words[2][b], words[3][b], 0x31)};
+			const std::size_t at[4] = {64 * b, 64 * b + 32, 64 * (b + 4), 64 * (b + 4) + 32};
+			#pragma GCC unroll 16
+			for(std::size_t i = 0; i < 4; i++)
+				_mm256_storeu_si256((__m256i*)(out + at[i]), _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(in + at[i])), parts[i]));
+		}
+	}
+#endif
+
+	// xors the keystream starting at block counter into length bytes, in may equal out
+	static void _xor_stream(const std::uint32_t state[16], std::uint32_t counter, const std::uint8_t* in, std::uint8_t* out, std::size_t length){
+#ifdef GIO_CHACHA20_AVX2
+		static const bool avx2 = __builtin_cpu_supports("avx2");
+		for(; avx2 && length >= 512; length -= 512, in += 512, out += 512, counter += 8)
+			_xor8_avx2(state, counter, in, out);
+#endif
+#ifdef GIO_CHACHA20_SSE2
+		for(; length >= 256; length -= 256, in += 256, out += 256, counter += 4)
+			_xor4_sse2(state, counter, in, out);
+#endif
+		std::uint8_t keystream[64];
+		for(; length; counter++){
+			_block_scalar(state, counter, keystream);
+			const std::size_t n = std::min<std::size_t>(length, 64);
+			for(std::size_t i = 0; i < n; i++)
+				out[i] = in[i] ^ keystream[i];
+			length -= n, in += n, out += n;
+		}
+	}
+
+	//? ======== Poly1305 ========>>====
+
+	struct _poly1305 {
+#ifdef __SIZEOF_INT128__
+		__extension__ typedef unsigned __int128 uint128;
+		static constexpr std::uint64_t mask44 = 0xfffffffffff, mask42 = 0x3ffffffffff;
+		std::uint64_t r[3], s[2], h[3] = {0, 0, 0}; // 44, 44 and 42 bit limbs
+
+		static std::uint64_t _get_u64(const std::uint8_t* in){
+			return (std::uint64_t)get_u32(in) | (std::uint64_t)get_u32(in + 4) << 32;
+		}
+
+		explicit _poly1305(const std::uint8_t key[32]){
+			const std::uint64_t t0 = _get_u64(key), t1 = _get_u64(key + 8);
+			r[0] = t0 & 0xffc0fffffff;
+			r[1] = ((t0 >> 44) | (t1 << 20)) & 0xfffffc0ffff;
+			r[2] = (t1 >> 24) & 0x00ffffffc0f;
+			s[0] = _get_u64(key + 16);
+			s[1] = _get_u64(key + 24);
+		}
+
+		void blocks(const std::uint8_t* m, std::size_t length){
+			const std::uint64_t r0 = r[0], r1 = r[1], r2 = r[2];
+			const std::uint64_t s1 = r1 * (5 << 2), s2 = r2 * (5 << 2);
+			std::uint64_t h0 = h[0], h1 = h[1], h2 = h[2];
+			for(; length >= 16; length -= 16, m += 16){
+				const std::uint64_t t0 = _get_u64(m), t1 = _get_u64(m + 8);
+				h0 += t0 & mask44;
+				h1 += ((t0 >> 44) | (t1 << 20)) & mask44;
+				h2 += ((t1 >> 24) & mask42) | ((std::uint64_t)1 << 40);
+				uint128 d0 = (uint128)h0 * r0 + (uint128)h1 * s2 + (uint128)h2 * s1;
+				uint128 d1 = (uint128)h0 * r1 + (uint128)h1 * r0 + (uint128)h2 * s2;
+				uint128 d2 = (uint128)h0 * r2 + (uint128)h1 * r1 + (uint128)h2 * r0;
+				d1 += (std::uint64_t)(d0 >> 44); h0 = (std::uint64_t)d0 & mask44;
+				d2 += (std::uint64_t)(d1 >> 44); h1 = (std::uint64_t)d1 & mask44;
+				h0 += (std::uint64_t)(d2 >> 42) * 5; h2 = (std::uint64_t)d2 & mask42;
+				h1 += h0 >> 44; h0 &= mask44;
+			}
+			h[0] = h0; h[1] = h1; h[2] = h2;
+		}
+
+		void finish(std::uint8_t tag[16]){
+			std::uint64_t h0 = h[0], h1 = h[1], h2 = h[2], c;
+			c = h1 >> 44; h1 &= mask44; h2 += c;
+			c = h2 >> 42; h2 &= mask42; h0 += c * 5;
+			c = h0 >> 44; h0 &= mask44; h1 += c;
+			c = h1 >> 44; h1 &= mask44; h2 += c;
+			c = h2 >> 42; h2 &= mask42; h0 += c * 5;
+			c = h0 >> 44; h0 &= mask44; h1 += c;
+			// h - p, selected in constant time when h >= p
+			std::uint64_t g0 = h0 + 5; c = g0 >> 44; g0 &= mask44;
+			std::uint64_t g1 = h1 + c; c = g1 >> 44; g1 &= mask44;
+			std::uint64_t g2 = h2 + c - ((std::uint64_t)1 << 42);
+			const std::uint64_t mask = (g2 >> 63) - 1;
+			h0 = (h0 & ~mask) | (g0 & mask); h1 = (h1 & ~mask) | (g1 & mask); h2 = (h2 & ~mask) | (g2 & mask);
+			h0 += s[0] & mask44; c = h0 >> 44; h0 &= mask44;
+			h1 += (((s[0] >> 44) | (s[1] << 20)) & mask44) + c; c = h1 >> 44; h1 &= mask44;
+			h2 += (s[1] >> 24) + c;
+			const std::uint64_t low = h0 | (h1 << 44), high = (h1 >> 20) | (h2 << 24);
+			put_u32(tag, (std::uint32_t)low); put_u32(tag + 4, (std::uint32_t)(low >> 32));
+			put_u32(tag + 8, (std::uint32_t)high); put_u32(tag + 12, (std::uint32_t)(high >> 32));
+		}
+#else
+		std::uint32_t r[5], s[4], h[5] = {0, 0, 0, 0, 0};
+
+		explicit _poly1305(const std::uint8_t key[32]){
+			r[0] = get_u32(key + 0) & 0x3ffffff;
+			r[1] = (get_u32(key + 3) >> 2) & 0x3ffff03;
+			r[2] = (get_u32(key + 6) >> 4) & 0x3ffc0ff;
+			r[3] = (get_u32(key + 9) >> 6) & 0x3f03fff;
+			r[4] = (get_u32(key + 12) >> 8) & 0x00fffff;
+			for(std::size_t i = 0; i < 4; i++)
+				s[i] = get_u32(key + 16 + 4 * i);
+		}
+
+		void blocks(const std::uint8_t* m, std::size_t length){
+			const std::uint64_t r0 = r[0], r1 = r[1], r2 = r[2], r3 = r[3], r4 = r[4];
+			const std::uint64_t s1 = r1 * 5, s2 = r2 * 5, s3 = r3 * 5, s4 = r4 * 5;
+			std::uint64_t h0 = h[0], h1 = h[1], h2 = h[2], h3 = h[3], h4 = h[4];
+			for(; length >= 16; length -= 16, m += 16){
+				h0 += get_u32(m + 0) & 0x3ffffff;
+				h1 += (get_u32(m + 3) >> 2) & 0x3ffffff;
+				h2 += (get_u32(m + 6) >> 4) & 0x3ffffff;
+				h3 += (get_u32(m + 9) >> 6) & 0x3ffffff;
+				h4 += (get_u32(m + 12) >> 8) | (1 << 24);
+				std::uint64_t d0 = h0 * r0 + h1 * s4 + h2 * s3 + h3 * s2 + h4 * s1;
+				std::uint64_t d1 = h0 * r1 + h1 * r0 + h2 * s4 + h3 * s3 + h4 * s2;
+				std::uint64_t d2 = h0 * r2 + h1 * r1 + h2 * r0 + h3 * s4 + h4 * s3;
+				std::uint64_t d3 = h0 * r3 + h1 * r2 + h2 * r1 + h3 * r0 + h4 * s4;
+				std::uint64_t d4 = h0 * r4 + h1 * r3 + h2 * r2 + h3 * r1 + h4 * r0;
+				d1 += d0 >> 26; h0 = d0 & 0x3ffffff;
+				d2 += d1 >> 26; h1 = d1 & 0x3ffffff;
+				d3 += d2 >> 26; h2 = d2 & 0x3ffffff;
+				d4 += d3 >> 26; h3 = d3 & 0x3ffffff;
+				h0 += (d4 >> 26) * 5; h4 = d4 & 0x3ffffff;
+				h1 += h0 >> 26; h0 &= 0x3ffffff;
+			}
+			h[0] = (std::uint32_t)h0; h[1] = (std::uint32_t)h1; h[2] = (std::uint32_t)h2; h[3] = (std::uint32_t)h3; h[4] = (std::uint32_t)h4;
+		}
+
+		void finish(std::uint8_t tag[16]){
+			std::uint32_t h0 = h[0], h1 = h[1], h2 = h[2], h3 = h[3], h4 = h[4], c;
+			c = h1 >> 26; h1 &= 0x3ffffff; h2 += c;
+			c = h2 >> 26; h2 &= 0x3ffffff; h3 += c;
+			c = h3 >> 26; h3 &= 0x3ffffff; h4 += c;
+			c = h4 >> 26; h4 &= 0x3ffffff; h0 += c * 5;
+			c = h0 >> 26; h0 &= 0x3ffffff; h1 += c;
+			// h - p, selected in constant time when h >= p
+			std::uint32_t g0 = h0 + 5; c = g0 >> 26; g0 &= 0x3ffffff;
+			std::uint32_t g1 = h1 + c; c = g1 >> 26; g1 &= 0x3ffffff;
+			std::uint32_t g2 = h2 + c; c = g2 >> 26; g2 &= 0x3ffffff;
+			std::uint32_t g3 = h3 + c; c = g3 >> 26; g3 &= 0x3ffffff;
+			std::uint32_t g4 = h4 + c - (1 << 26);
+			const std::uint32_t mask = (g4 >> 31) - 1;
+			h0 = (h0 & ~mask) | (g0 & mask); h1 = (h1 & ~mask) | (g1 & mask); h2 = (h2 & ~mask) | (g2 & mask);
+			h3 = (h3 & ~mask) | (g3 & mask); h4 = (h4 & ~mask) | (g4 & mask);
+			const std::uint32_t words[4] = {h0 | (h1 << 26), (h1 >> 6) | (h2 << 20), (h2 >> 12) | (h3 << 14), (h3 >> 18) | (h4 << 8)};
+			std::uint64_t f = 0;
+			for(std::size_t i = 0; i < 4; i++){
+				f = (std::uint64_t)words[i] + s[i] + (f >> 32);
+				put_u32(tag + 4 * i, (std::uint32_t)f);
+			}
+		}
+#endif
+
+		// the message zero padded to a multiple of 16 bytes, as the AEAD construction requires
+		void padded(const void* data, const std::size_t length){
+			const std::uint8_t* m = (const std::uint8_t*)data;
+			blocks(m, length);
+			if(length % 16){
+				std::uint8_t last[16] = {};
+				std::memcpy(last, m + length / 16 * 16, length % 16);
+				blocks(last, 16);
+			}
+		}
+	};
+
+	static void _tag(const std::uint32_t state[16], const void* aad, const std::size_t aad_length, const void* data, const std::size_t length, std::uint8_t tag[16]){
+		std::uint8_t key[64];
+		_block_scalar(state, 0, key);
+		_poly1305 mac(key);
+		mac.padded(aad, aad_length);
+		mac.padded(data, length);
+		std::uint8_t lengths[16];
+		put_u32(lengths + 0, (std::uint32_t)aad_length); put_u32(lengths + 4, (std::uint32_t)((std::uint64_t)aad_length >> 32));
+		put_u32(lengths + 8, (std::uint32_t)length); put_u32(lengths + 12, (std::uint32_t)((std::uint64_t)length >> 32));
+		mac.blocks(lengths, 16);
+		mac.finish(tag);
+	}
+
+	//? ======== Framing ========>>====
+
+	static void _nonce(const std::uint32_t index, const std::uint8_t salt[salt_size], std::uint8_t nonce[12]){
+		put_u32(nonce, index);
+		std::memcpy(nonce + 4, salt, salt_size);
+	}
+
+	[[noreturn]] void _fail(const std::string& reason) const {
+		throw iGIO::IOfailure("Error reading: ChaCha20-Poly1305 filter " + reason + " in the block at offset " + std::to_string(_offset));
+	}
+
+	// encrypts frame, a length header followed by the plaintext, with the next write nonce and writes it
+	void _seal_frame(std::vector<char>& frame, stage& next){
+		const std::size_t length = frame.size() - header_size;
+		if(!_write_started){
+			std::random_device random;
+			for(std::size_t i = 0; i < salt_size; i += 4)
+				put_u32(_write_salt + i, random());
+			next.write((const char*)_write_salt, salt_size);
+			_write_started = true;
+		}
+		if(_write_index == UINT32_MAX)
+			throw iGIO::IOfailure("Error writing: ChaCha20-Poly1305 filter exhausted the block nonces of the stream");
+		put_u32(frame.data(), (std::uint32_t)length);
+		frame.resize(frame.size() + tag_size);
+		std::uint8_t nonce[12];
+		_nonce(_write_index++, _write_salt, nonce);
+		seal(_key, nonce, frame.data(), header_size, frame.data() + header_size, length, frame.data() + header_size + length);
+		next.write(frame.data(), frame.size());
+	}
+
+	// whether the segment being read is the one this filter is writing, which has no end block yet
+	bool _reading_own() const {
+		return _write_started && !_write_ended && std::memcmp(_read_salt, _write_salt, salt_size) == 0;
+	}
+protected:
+	void write_block(std::vector<char>& frame, stage& next) override{
+		_seal_frame(frame, next);
+	}
+
+	// reads, authenticates and decrypts the next block, the end block of a segment is followed by the salt of the next one
+	bool read_block(std::vector<char>& block, std::size_t& first, stage& next) override{
+		for(;;){
+			if(!_read_started){
+				_offset = read_offset();
+				const std::size_t n = read_full(next, (char*)_read_salt, salt_size);
+				if(!n)
+					return false;
+				if(n < salt_size)
+					_fail("found a truncated salt");
+				_read_started = true;
+				_read_index = 0;
+			}
+			_offset = read_offset();
+			block.resize(header_size);
+			const std::size_t n = read_full(next, block.data(), header_size);
+			if(!n){
+				if(_reading_own())
+					return false;
+				_fail("found no end block, the stream was truncated");
+			}
+			if(n < header_size)
+				_fail("found a truncated header");
+			const std::size_t length = get_u32(block.data());
+			if(length > max_block_size)
+				_fail("found a corrupt length of " + std::to_string(length));
+			block.resize(header_size + length + tag_size);
+			if(read_full(next, block.data() + header_size, length + tag_size) != length + tag_size)
+				_fail("found a truncated block");
+			std::uint8_t nonce[12];
+			_nonce(_read_index, _read_salt, nonce);
+			if(!open(_key, nonce, block.data(), header_size, block.data() + header_size, length, block.data() + header_size + length))
+				_fail("failed authentication");
+			_read_index++;
+			if(!length){ // the end block
+				_read_started = false;
+				continue;
+			}
+			block.resize(header_size + length);
+			first = header_size;
+			return true;
+		}
+	}
+public:
+	/**
+	 * @brief Writes the last block and the authenticated empty end block, called by remove_filters()
+	 */
+	void finish(stage& next) override{
+		gio_block_filter::flush(next);
+		if(!_write_started || _write_ended)
+			return;
+		std::vector<char> end(header_size);
+		_seal_frame(end, next);
+		_write_ended = true;
+	}
+
+	/**
+	 * @brief Creates an encryption filter
+	 * @param key The 256 bit key, the same key must be used to read the stream
+	 * @param block_size The amount of bytes encrypted and authenticated together, at most 16 MiB
+	 */
+	explicit gio_chacha20_filter(const key_type& key, const std::size_t block_size = 64 * 1024)
+		: gio_block_filter(std::min(block_size, max_block_size), header_size, tag_size), _key(key) {}
+	~gio_chacha20_filter(){
+		volatile std::uint8_t* key = _key.data();
+		for(std::size_t i = 0; i < _key.size(); i++)
+			key[i] = 0;
+	}
+
+	/**
+	 * @brief Encrypts data in place and computes its tag, as AEAD_CHACHA20_POLY1305 of RFC 8439
+	 * @param key The 256 bit key
+	 * @param nonce The 96 bit nonce, never reused with the same key
+	 * @param aad The additional authenticated data
+	 * @param aad_length The amount of additional authenticated bytes
+	 * @param data The plaintext, replaced by the ciphertext
+	 * @param length The amount of bytes
+	 * @param tag The 16 bytes receiving the tag
+	 */
+	static void seal(const key_type& key, const std::uint8_t nonce[12], const void* aad, const std::size_t aad_length, void* data, const std::size_t length, void* tag){
+		std::uint32_t state[16];
+		_state(key, nonce, state);
+		_xor_stream(state, 1, (const std::uint8_t*)data, (std::uint8_t*)data, length);
+		_tag(state, aad, aad_length, data, length, (std::uint8_t*)tag);
+	}
+
+	/**
+	 * @brief Authenticates data and decrypts it in place, see seal()
+	 * @return bool Whether the tag matched, data is left encrypted if not
+	 */
+	static bool open(const key_type& key, const std::uint8_t nonce[12], const void* aad, const std::size_t aad_length, void* data, const std::size_t length, const void* tag){
+		std::uint32_t state[16];
+		_state(key, nonce, state);
+		std::uint8_t expected[16];
+		_tag(state, aad, aad_length, data, length, expected);
+		std::uint8_t difference = 0;
+		for(std::size_t i = 0; i < 16; i++)
+			difference |= expected[i] ^ ((const std::uint8_t*)tag)[i];
+		if(difference)
+			return false;
+		_xor_stream(state, 1, (const std::uint8_t*)data, (std::uint8_t*)data, length);
+		return true;
+	}
+
+	/**
+	 * @brief The widest ChaCha20 implementation the processor supports, "avx2", "sse2" or "scalar"
+	 */
+	static const char* implementation(){
+#ifdef GIO_CHACHA20_AVX2
+		if(__builtin_cpu_supports("avx2"))
+			return "avx2";
+#endif
+#ifdef GIO_CHACHA20_SSE2
+		return "sse2";
+#else
+		return "scalar";
+#endif
+	}
+};
@@ -0,0 +1,164 @@
+#pragma once
+#include "GRWI.hpp"
+
+#include <vector>
+#include <array>
+#include <string>
+#include <cstring>
+#include <cstdint>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <nmmintrin.h>
+#define GIO_CRC32C_SSE42 1
+#endif
+
+/**
+ * @brief CRC32C (Castagnoli) checksums, using the SSE4.2 crc32 instruction when the processor supports it
+ * and a portable slicing-by-8 table implementation otherwise, selected once at runtime.
+ */
+struct gio_crc32c {
+	/**
+	 * @brief Computes the CRC32C of data, continuing from the CRC of the data before it
+	 * @param data The bytes to checksum
+	 * @param length The amount of bytes
+	 * @param crc The CRC of the preceding bytes, 0 to start
+	 * @return std::uint32_t The CRC of the preceding bytes followed by data
+	 */
+	static std::uint32_t compute(const void* data, const std::size_t length, const std::uint32_t crc = 0){
+		static const auto implementation = accelerated() ? &_compute_sse42 : &compute_portable;
+		return implementation(data, length, crc);
+	}
+
+	/**
+	 * @brief Computes the CRC32C of data with the slicing-by-8 tables, see compute()
+	 */
+	static std::uint32_t compute_portable(const void* data, const std::size_t length, std::uint32_t crc = 0){
+		static const auto tables = _make_tables();
+		const unsigned char* p = (const unsigned char*)data;
+		std::size_t n = length;
+		crc = ~crc;
+		for(; n >= 8; n -= 8, p += 8){
+			crc ^= (std::uint32_t)p[0] | (std::uint32_t)p[1] << 8 | (std::uint32_t)p[2] << 16 | (std::uint32_t)p[3] << 24;
+			crc = tables[7][crc & 0xFF] ^ tables[6][(crc >> 8) & 0xFF] ^ tables[5][(crc >> 16) & 0xFF] ^ tables[4][crc >> 24]
+				^ tables[3][p[4]] ^ tables[2][p[5]] ^ tables[1][p[6]] ^ tables[0][p[7]];
+		}
+		for(; n; n--, p++)
+			crc = tables[0][(crc ^ *p) & 0xFF] ^ (crc >> 8);
+		return ~crc;
+	}
+
+	/**
+	 * @brief Whether compute() uses the crc32 instruction
+	 */
+	static bool accelerated(){
+#ifdef GIO_CRC32C_SSE42
+		static const bool supported = __builtin_cpu_supports("sse4.2");
+		return supported;
+#else
+		return false;
+#endif
+	}
+private:
+	static std::array<std::array<std::uint32_t, 256>, 8> _make_tables(){
+		std::array<std::array<std::uint32_t, 256>, 8> tables;
+		for(std::uint32_t i = 0; i < 256; i++){
+			std::uint32_t crc = i;
+			for(int bit = 0; bit < 8; bit++)
+				crc = crc & 1 ? (crc >> 1) ^ 0x82F63B78u : crc >> 1;
+			tables[0][i] = crc;
+		}
+		for(std::size_t k = 1; k < 8; k++)
+			for(std::size_t i = 0; i < 256; i++)
+				tables[k][i] = (tables[k - 1][i] >> 8) ^ tables[0][tables[k - 1][i] & 0xFF];
+		return tables;
+	}
+
+#ifdef GIO_CRC32C_SSE42
+	__attribute__((target("sse4.2")))
+	static std::uint32_t _compute_sse42(const void* data, const std::size_t length, const std::uint32_t crc){
+		const unsigned char* p = (const unsigned char*)data;
+		std::size_t n = length;
+#ifdef __x86_64__
+		std::uint64_t state = ~crc;
+		for(; n >= 8; n -= 8, p += 8){
+			std::uint64_t value;
+			std::memcpy(&value, p, sizeof(value));
+			state = _mm_crc32_u64(state, value);
+		}
+		std::uint32_t state32 = (std::uint32_t)state;
+#else
+		std::uint32_t state32 = ~crc;
+#endif
+		for(; n >= 4; n -= 4, p += 4){
+			std::uint32_t value;
+			std::memcpy(&value, p, sizeof(value));
+			state32 = _mm_crc32_u32(state32, value);
+		}
+		for(; n; n--, p++)
+			state32 = _mm_crc32_u8(state32, *p);
+		return ~state32;
+	}
+#else
+	static std::uint32_t _compute_sse42(const void* data, const std::size_t length, const std::uint32_t crc){
+		return compute_portable(data, length, crc);
+	}
+#endif
+};
+
+/**
+ * @brief Integrity filter appending a CRC32C to every block and verifying it on read, see iGIO::add_filter()
+ * Written bytes are collected into blocks of block_size bytes, a block is written when it is full or on flush().
+ * Every block is stored as a little endian std::uint32_t length, the bytes, and the little endian CRC32C of length and bytes.
+ * Reads verify every block before returning its bytes and throw IOfailure with the block's offset on a mismatch.
+ */
+class gio_crc32c_filter : public gio_block_filter {
+private:
+	static constexpr std::size_t header_size = 4;
+	static constexpr std::size_t trailer_size = 4;
+	static constexpr std::size_t max_block_size = std::size_t(1) << 24;
+
+	std::uint64_t _offset = 0; // offset in the underlying stream of the block being read
+
+	[[noreturn]] void _fail(const std::string& reason) const {
+		throw iGIO::IOfailure("Error reading: CRC32C filter " + reason + " in the block at offset " + std::to_string(_offset));
+	}
+protected:
+	void write_block(std::vector<char>& frame, stage& next) override{
+		const std::size_t length = frame.size() - header_size;
+		put_u32(frame.data(), (std::uint32_t)length);
+		frame.resize(frame.size() + trailer_size);
+		put_u32(frame.data() + header_size + length, gio_crc32c::compute(frame.data(), header_size + length));
+		next.write(frame.data(), frame.size());
+	}
+
+	// reads and verifies the next block
+	bool read_block(std::vector<char>& block, std::size_t& first, stage& next) override{
+		_offset = read_offset();
+		block.resize(header_size);
+		const std::size_t n = read_full(next, block.data(), header_size);
+		if(!n)
+			return false;
+		if(n < header_size)
+			_fail("found a truncated header");
+		const std::size_t length = get_u32(block.data());
+		if(!length || length > max_block_size)
+			_fail("found a corrupt length of " + std::to_string(length));
+		block.resize(header_size + length + trailer_size);
+		if(read_full(next, block.data() + header_size, length + trailer_size) != length + trailer_size)
+			_fail("found a truncated block");
+		const std::uint32_t stored = get_u32(block.data() + header_size + length);
+		const std::uint32_t computed = gio_crc32c::compute(block.data(), header_size + length);
+		if(stored != computed)
+			_fail("found a checksum mismatch, stored " + std::to_string(stored) + " computed " + std::to_string(computed));
+		block.resize(header_size + length);
+		first = header_size;
+		return true;
+	}
+public:
+	/**
+	 * @brief Creates an integrity filter
+	 * @param block_size The amount of bytes covered by one CRC, at most 16 MiB
+	 */
+	explicit gio_crc32c_filter(const std::size_t block_size = 64 * 1024)
+		: gio_block_filter(std::min(block_size, max_block_size), header_size, trailer_size) {}
+};
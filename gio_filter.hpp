@@ -0,0 +1,195 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+/**
+ * @brief Byte stream transform stacked between the read and write functions of an interface and its backend, e.g. compression,
+ * checksumming, framing or encryption. Attached with iGIO::add_filter(), the first filter added is nearest to the application.
+ * A filter receives whole buffers and passes its output to the next stage, which is the next filter or the backend's
+ * iRead()/iWrite()/iFlush(). Filters can keep state and buffered bytes between calls.
+ */
+class gio_filter {
+public:
+	/**
+	 * @brief The next stage of a pipeline, towards the backend
+	 */
+	class stage {
+	public:
+		/**
+		 * @brief Writes bytes to the next stage
+		 * @return std::size_t The amount of bytes written
+		 */
+		virtual std::size_t write(const char* data, const std::size_t length) = 0;
+		/**
+		 * @brief Reads bytes from the next stage, with the short read behaviour of the backend's iRead()
+		 * @return std::size_t The amount of bytes read, 0 if no data is available
+		 */
+		virtual std::size_t read(char* buffer, const std::size_t length) = 0;
+		/**
+		 * @brief Flushes the next stage
+		 */
+		virtual void flush() = 0;
+	protected:
+		~stage() = default;
+	};
+
+	virtual ~gio_filter() = default;
+
+	/**
+	 * @brief Transforms bytes written by the application and writes the result to next, bytes may be kept until a later call or flush()
+	 * IMPLEMENTATION: Consumes all length bytes or throws
+	 * @param data The bytes to transform
+	 * @param length The amount of bytes
+	 * @param next The next stage
+	 * @return std::size_t The amount of bytes consumed
+	 */
+	virtual std::size_t write(const char* data, const std::size_t length, stage& next) = 0;
+
+	/**
+	 * @brief Reads bytes from next and transforms them for the application
+	 * IMPLEMENTATION: Has the same implemenation requirements as the default iRead method, returns fewer than length bytes
+	 * only when next returned fewer bytes than needed, and returns 0 only when next has no data available
+	 * @param buffer The buffer to read into
+	 * @param length The maximum amount of bytes to read
+	 * @param next The next stage
+	 * @return std::size_t The amount of bytes read
+	 */
+	virtual std::size_t read(char* buffer, const std::size_t length, stage& next) = 0;
+
+	/**
+	 * @brief Writes the bytes kept by write() to next, then flushes next. Called by flush(), endl() and remove_filters()
+	 * @param next The next stage
+	 */
+	virtual void flush(stage& next){
+		next.flush();
+	}
+
+	/**
+	 * @brief Ends the stream written by this filter, e.g. with an end marker. Called by remove_filters() after flush(),
+	 * in order from the filter nearest to the application, the backend is flushed afterwards
+	 * IMPLEMENTATION: Writes the bytes kept by write() before its own, defaults to flush()
+	 * @param next The next stage
+	 */
+	virtual void finish(stage& next){
+		flush(next);
+	}
+};
+
+/**
+ * @brief Base of filters transforming whole blocks, e.g. compression, checksumming and encryption, see gio_filter
+ * Written bytes are collected into blocks of block_size bytes, a block is passed to write_block() when it is full or on flush().
+ * read() returns the bytes of the blocks decoded by read_block() one after the other.
+ * Written and read blocks are kept in separate buffers, so reads and writes can be interleaved.
+ */
+class gio_block_filter : public gio_filter {
+	const std::size_t _block_size;
+	const std::size_t _header_size;
+	std::vector<char> _written; // header room and the bytes written since the last block
+	std::vector<char> _read; // the block being returned by read()
+	std::size_t _read_pos = 0; // position of the next byte to return in _read
+	std::size_t _read_end = 0;
+	std::uint64_t _read_offset = 0; // bytes read from the next stage by read_full()
+
+	void _write_block(stage& next){
+		if(_written.size() == _header_size)
+			return;
+		write_block(_written, next);
+		_written.resize(_header_size);
+	}
+protected:
+	/**
+	 * @brief Creates a block filter
+	 * @param block_size The amount of bytes collected into a block
+	 * @param header_size The bytes reserved before the bytes of a block, filled in by write_block()
+	 * @param trailer_size The bytes reserved after the bytes of a block, appended by write_block()
+	 */
+	explicit gio_block_filter(const std::size_t block_size, const std::size_t header_size = 0, const std::size_t trailer_size = 0)
+		: _block_size(std::max<std::size_t>(block_size, 1)), _header_size(header_size) {
+		_written.reserve(_header_size + _block_size + trailer_size);
+		_written.resize(_header_size);
+	}
+
+	/**
+	 * @brief Encodes a block and writes it to next, called with at least one byte
+	 * @param frame The header_size reserved bytes followed by the bytes of the block, can be modified and grown
+	 * @param next The next stage
+	 */
+	virtual void write_block(std::vector<char>& frame, stage& next) = 0;
+
+	/**
+	 * @brief Reads and decodes the next block from next, throws when it is corrupt
+	 * @param block Receives the decoded block
+	 * @param first Receives the offset of the first byte in block that read() returns, the bytes up to block.size() are returned
+	 * @param next The next stage
+	 * @return bool false if next has no more data
+	 */
+	virtual bool read_block(std::vector<char>& block, std::size_t& first, stage& next) = 0;
+
+	/**
+	 * @brief Reads from next until length bytes are read or next has no more data
+	 * @return std::size_t The amount of bytes read
+	 */
+	std::size_t read_full(stage& next, char* buffer, const std::size_t length){
+		std::size_t n = 0;
+		for(std::size_t r; n < length && (r = next.read(buffer + n, length - n)); )
+			n += r;
+		_read_offset += n;
+		return n;
+	}
+
+	/**
+	 * @brief The amount of bytes read from the next stage through read_full(), e.g. the offset of a corrupt block
+	 */
+	std::uint64_t read_offset() const {
+		return _read_offset;
+	}
+
+	static void put_u32(void* out, const std::uint32_t value){
+		unsigned char* p = (unsigned char*)out;
+		for(std::size_t i = 0; i < 4; i++)
+			p[i] = (unsigned char)(value >> (8 * i));
+	}
+	static std::uint32_t get_u32(const void* in){
+		const unsigned char* p = (const unsigned char*)in;
+		return (std::uint32_t)p[0] | (std::uint32_t)p[1] << 8 | (std::uint32_t)p[2] << 16 | (std::uint32_t)p[3] << 24;
+	}
+public:
+	std::size_t write(const char* data, const std::size_t length, stage& next) override{
+		for(std::size_t n = 0; n < length;){
+			const std::size_t k = std::min(length - n, _block_size - (_written.size() - _header_size));
+			_written.insert(_written.end(), data + n, data + n + k);
+			n += k;
+			if(_written.size() - _header_size == _block_size)
+				_write_block(next);
+		}
+		return length;
+	}
+
+	std::size_t read(char* buffer, const std::size_t length, stage& next) override{
+		std::size_t n = 0;
+		while(n < length){
+			if(_read_pos == _read_end){
+				std::size_t first = 0;
+				_read_pos = _read_end = 0; // stays empty when read_block() throws
+				if(!read_block(_read, first, next))
+					break;
+				_read_pos = first;
+				_read_end = _read.size();
+				continue;
+			}
+			const std::size_t k = std::min(length - n, _read_end - _read_pos);
+			std::copy(_read.data() + _read_pos, _read.data() + _read_pos + k, buffer + n);
+			_read_pos += k;
+			n += k;
+		}
+		return n;
+	}
+
+	void flush(stage& next) override{
+		_write_block(next);
+		next.flush();
+	}
+};
@@ -0,0 +1,189 @@
+#pragma once
+#include "GRWI.hpp"
+
+#include <vector>
+#include <stdexcept>
+#include <cstdint>
+
+/**
+ * @brief Sidecar index of line offsets for text read line by line, e.g. with read_until() or lines()
+ * The text is scanned once for the interface's LineEnder with memchr, and the offset of every stride-th line is stored
+ * in a sidecar interface. Later opens continue from the stored state, so only appended text is scanned.
+ * Lines appended through endl() are indexed as they are written.
+ * Requires positional access to the text and the sidecar.
+ * Sidecar layout, native std::uint64_t values: stride, scanned bytes, lines, then the offset of line 0, stride, 2 * stride, ...
+ */
+class gio_line_index {
+public:
+	/**
+	 * @brief A range of whole lines, returned by chunks()
+	 */
+	struct chunk {
+		std::uint64_t begin;		// byte offset of the first line
+		std::uint64_t end;			// byte offset after the last line
+		std::uint64_t first_line;	// number of the first line
+	};
+private:
+	iGIO& _text;
+	iGIO& _sidecar;
+	const std::uint64_t _stride;
+	std::uint64_t _scanned = 0; // text before this offset has been indexed
+	std::uint64_t _lines = 0; // the amount of line enders found
+	std::vector<std::uint64_t> _checkpoints; // offset of line k * stride
+	std::unique_ptr<char[]> _buffer;
+	std::size_t _buffer_size = 0;
+
+	static constexpr std::size_t header_values = 3;
+
+	void _save_header(){
+		const std::uint64_t header[header_values] = {_stride, _scanned, _lines};
+		_sidecar.write_at(0, header, header_values);
+	}
+
+	void _reset(){
+		_scanned = _lines = 0;
+		_checkpoints.assign(1, 0);
+		_sidecar.write_at(header_values * sizeof(std::uint64_t), _checkpoints[0]);
+		_save_header();
+	}
+
+	void _load(){
+		std::uint64_t header[header_values] = {0, 0, 0};
+		if(_sidecar.size() < sizeof(header) || _sidecar.read_at(0, header, header_values) != header_values || header[0] != _stride)
+			return _reset();
+		_scanned = header[1];
+		_lines = header[2];
+		_checkpoints.resize(_lines / _stride + 1);
+		if(_sidecar.read_at(header_values * sizeof(std::uint64_t), _checkpoints.data(), _checkpoints.size()) != _checkpoints.size() || _scanned > _text.size())
+			return _reset(); // the sidecar is incomplete or the text was truncated
+	}
+
+	/**
+	 * @brief Searches [begin, end) of the text for line enders, reading it in ChunkBytes sized positional reads
+	 * @param found Called with the offset after every line ender, scanning stops when it returns false
+	 * @return std::uint64_t The offset scanning can continue from, a line ender split by end is found again
+	 */
+	template<typename Found>
+	std::uint64_t _scan(const std::uint64_t begin, const std::uint64_t end, Found&& found){
+		const std::string_view ender(_text.LineEnder);
+		const std::size_t overlap = ender.size() - 1;
+		if(_buffer_size < std::max(_text.ChunkBytes, ender.size() * 2)){
+			_buffer_size = std::max(_text.ChunkBytes, ender.size() * 2);
+			_buffer = std::make_unique<char[]>(_buffer_size);
+		}
+		std::uint64_t resume = begin, pos = begin;
+		while(pos < end){
+			const std::size_t length = (std::size_t)std::min<std::uint64_t>(_buffer_size, end - pos);
+			const std::size_t n = _text.read_at(pos, _buffer.get(), length);
+			for(const char* first = _buffer.get(); (first = iGIO::find_terminator(first, _buffer.get() + n, ender)); ){
+				first += ender.size();
+				resume = pos + (first - _buffer.get());
+				if(!found(resume))
+					return resume;
+			}
+			if(n < length || pos + n == end){
+				pos += n;
+				break;
+			}
+			pos = std::max(pos + n - overlap, resume); // rescan the bytes that may hold the start of a split line ender
+		}
+		return std::max(resume, pos - std::min<std::uint64_t>(overlap, pos - begin));
+	}
+public:
+	/**
+	 * @brief Opens the index of a text, loading it from the sidecar and indexing text that is not indexed yet
+	 * Registers the index with the text's endl(), only one index can be registered per interface.
+	 * Throws std::runtime_error if the text already has an index registered.
+	 * @param text The interface containing the text, requires positional access
+	 * @param sidecar The interface storing the index, requires positional access
+	 * @param stride Every stride-th line offset is stored, a stored index with a different stride is rebuilt
+	 */
+	gio_line_index(iGIO& text, iGIO& sidecar, const std::size_t stride = 1024)
+		: _text(text), _sidecar(sidecar), _stride(std::max<std::size_t>(stride, 1)) {
+		if(_text._on_endl)
+			throw std::runtime_error("failed to index lines, the interface already has a line index");
+		_load();
+		update();
+		_text._on_endl = [this]{ update(); };
+	}
+	gio_line_index(const gio_line_index&) = delete;
+	gio_line_index& operator=(const gio_line_index&) = delete;
+	~gio_line_index(){
+		_text._on_endl = nullptr; // the constructor made sure the hook is this index's
+	}
+
+	/**
+	 * @brief Indexes the text appended since the last update and stores new offsets in the sidecar
+	 * Called by endl(), should be called after appending lines with other functions.
+	 */
+	void update(){
+		const std::uint64_t end = _text.size();
+		if(end <= _scanned)
+			return;
+		const std::size_t stored = _checkpoints.size();
+		_scanned = _scan(_scanned, end, [&](std::uint64_t line_begin){
+			if(++_lines % _stride == 0)
+				_checkpoints.push_back(line_begin);
+			return true;
+		});
+		if(_checkpoints.size() > stored)
+			_sidecar.write_at((header_values + stored) * sizeof(std::uint64_t), _checkpoints.data() + stored, _checkpoints.size() - stored);
+		_save_header(); // written after the offsets, so a stored header never refers to missing offsets
+	}
+
+	/**
+	 * @brief The amount of line enders in the indexed text, lines 0 up to and including lines() can be located
+	 * @return std::uint64_t The amount of line enders
+	 */
+	std::uint64_t lines() const {
+		return _lines;
+	}
+
+	/**
+	 * @brief The byte offset of a line, reads at most stride lines of text from the nearest stored offset
+	 * Throws IOfailure if the line is not in the indexed text
+	 * @param line The number of the line, starting at 0
+	 * @return std::uint64_t The byte offset of the first character of the line
+	 */
+	std::uint64_t offset(const std::uint64_t line){
+		if(line > _lines)
+			throw iGIO::IOfailure("Error reading line index: line " + std::to_string(line) + " is past the " + std::to_string(_lines) + " indexed lines");
+		std::uint64_t offset = _checkpoints[line / _stride];
+		std::uint64_t remaining = line % _stride;
+		if(remaining)
+			_scan(offset, _scanned, [&](std::uint64_t line_begin){
+				offset = line_begin;
+				return --remaining != 0;
+			});
+		return offset;
+	}
+
+	/**
+	 * @brief Moves the read position of the text to the start of a line, see offset()
+	 * @param line The number of the line, starting at 0
+	 */
+	void seek_line(const std::uint64_t line){
+		_text.seek(offset(line));
+	}
+
+	/**
+	 * @brief Splits the indexed text into at most count ranges of whole lines with about the same amount of bytes
+	 * Ranges start at stored offsets, so they are balanced up to stride lines.
+	 * @param count The amount of ranges to split into
+	 * @return std::vector<chunk> The ranges in order, together covering all of the text
+	 */
+	std::vector<chunk> chunks(const std::size_t count){
+		const std::uint64_t end = _text.size();
+		std::vector<chunk> ranges;
+		ranges.push_back({0, end, 0});
+		for(std::size_t i = 1; i < count; i++){
+			const std::uint64_t target = end / count * i + end % count * i / count;
+			std::size_t k = std::upper_bound(_checkpoints.begin(), _checkpoints.end(), target) - _checkpoints.begin() - 1;
+			if(_checkpoints[k] <= ranges.back().begin)
+				continue;
+			ranges.back().end = _checkpoints[k];
+			ranges.push_back({_checkpoints[k], end, k * _stride});
+		}
+		return ranges;
+	}
+};
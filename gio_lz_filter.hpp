@@ -0,0 +1,257 @@
+#pragma once
+#include "GRWI.hpp"
+
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief Block LZ compression filter, see iGIO::add_filter()
+ * Written bytes are collected into blocks of block_size bytes, a block is compressed when it is full or on flush().
+ * Every block is stored as a header of two little endian std::uint32_t, the raw size and the stored size,
+ * followed by the stored bytes. A stored size of 0 marks a block kept raw because it did not compress.
+ * Compressed blocks are LZ77 sequences: a token with the literal and match length, the literals, a 16 bit match offset.
+ * The level selects speed against ratio: 0 stores blocks raw, 1 tries one match candidate per position,
+ * higher levels follow a hash chain of up to 2^(level - 1) candidates.
+ * Reads decompress one block at a time. Throws IOfailure when a block is corrupt or truncated.
+ */
+class gio_lz_filter : public gio_block_filter {
+public:
+	/**
+	 * @brief Counters of a filter, all sizes in bytes
+	 */
+	struct stats {
+		std::uint64_t raw = 0;		// bytes before compression
+		std::uint64_t stored = 0;	// bytes after compression, including the block headers
+		std::uint64_t blocks = 0;	// blocks written
+	};
+private:
+	static constexpr std::size_t header_size = 8;
+	static constexpr std::size_t min_match = 4;
+	static constexpr std::size_t max_offset = 65535;
+	static constexpr std::size_t hash_bits = 16;
+	static constexpr std::size_t window_mask = 65535;
+	static constexpr std::size_t max_block_size = std::size_t(1) << 24;
+
+	const int _level;
+	stats _stats;
+
+	std::vector<char> _stored; // header and stored bytes of a block
+	std::vector<std::uint32_t> _head; // position + 1 of the last occurrence of every hash, 0 if none
+	std::vector<std::uint32_t> _chain; // position + 1 of the previous occurrence with the same hash, by position & window_mask
+
+	static std::uint32_t _read32(const unsigned char* p){
+		std::uint32_t value;
+		std::memcpy(&value, p, sizeof(value));
+		return value;
+	}
+	static std::uint32_t _hash(const unsigned char* p){
+		return (_read32(p) * 2654435761u) >> (32 - hash_bits);
+	}
+	static unsigned char* _put_length(unsigned char* out, std::size_t length){
+		for(; length >= 255; length -= 255)
+			*out++ = 255;
+		*out++ = (unsigned char)length;
+		return out;
+	}
+	static unsigned char* _put_sequence(unsigned char* out, const unsigned char* literals, const std::size_t literal_length, const std::size_t offset, const std::size_t match_length){
+		unsigned char* token = out++;
+		*token = (unsigned char)(std::min<std::size_t>(literal_length, 15) << 4);
+		if(literal_length >= 15)
+			out = _put_length(out, literal_length - 15);
+		std::memcpy(out, literals, literal_length);
+		out += literal_length;
+		if(!match_length) // the last sequence of a block has no match
+			return out;
+		*out++ = (unsigned char)offset;
+		*out++ = (unsigned char)(offset >> 8);
+		*token |= (unsigned char)std::min<std::size_t>(match_length - min_match, 15);
+		if(match_length - min_match >= 15)
+			out = _put_length(out, match_length - min_match - 15);
+		return out;
+	}
+
+	// the length of the match of at least min_match bytes between position and i, compared 8 bytes at a time
+	static std::size_t _match_length(const unsigned char* in, const std::size_t position, const std::size_t i, const std::size_t length){
+		std::size_t match = min_match;
+		while(i + match + 8 <= length){
+			std::uint64_t a, b;
+			std::memcpy(&a, in + position + match, 8);
+			std::memcpy(&b, in + i + match, 8);
+			if(a != b){
+#if defined(__GNUC__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+				return match + (__builtin_ctzll(a ^ b) >> 3);
+#else
+				break;
+#endif
+			}
+			match += 8;
+		}
+		while(i + match < length && in[position + match] == in[i + match])
+			match++;
+		return match;
+	}
+
+	/**
+	 * @brief Compresses a block into out, which must hold at least _bound(length) bytes
+	 * @return std::size_t The compressed size, 0 if the block does not get smaller
+	 */
+	std::size_t _compress(const char* block, const std::size_t length, char* compressed){
+		const unsigned char* in = (const unsigned char*)block;
+		unsigned char* out = (unsigned char*)compressed;
+		std::fill(_head.begin(), _head.end(), 0);
+		const std::size_t depth = _level > 1 ? std::size_t(1) << std::min(_level - 1, 12) : 1;
+		const std::size_t match_limit = length > 12 ? length - 12 : 0; // leaves room to read 4 bytes at every candidate position
+		std::size_t anchor = 0, misses = 0;
+		for(std::size_t i = 0; i < match_limit;){
+			const std::uint32_t h = _hash(in + i);
+			std::size_t candidate = _head[h];
+			_head[h] = (std::uint32_t)(i + 1);
+			if(depth > 1)
+				_chain[i & window_mask] = (std::uint32_t)candidate;
+			std::size_t best_length = 0, best_offset = 0;
+			for(std::size_t probe = 0; candidate && probe < depth; probe++){
+				const std::size_t position = candidate - 1;
+				if(i - position > max_offset)
+					break;
+				if(_read32(in + position) == _read32(in + i)){
+					const std::size_t match = _match_length(in, position, i, length);
+					if(match > best_length){
+						best_length = match;
+						best_offset = i - position;
+					}
+				}
+				if(depth == 1)
+					break;
+				candidate = _chain[position & window_mask];
+			}
+			if(!best_length){
+				i += 1 + (misses++ >> 5); // skip faster through incompressible data
+				continue;
+			}
+			misses = 0;
+			out = _put_sequence(out, in + anchor, i - anchor, best_offset, best_length);
+			const std::size_t end = i + best_length;
+			if(depth > 1) // index the positions inside the match for the hash chains
+				for(std::size_t j = i + 1; j < end && j < match_limit; j++){
+					const std::uint32_t hj = _hash(in + j);
+					_chain[j & window_mask] = _head[hj];
+					_head[hj] = (std::uint32_t)(j + 1);
+				}
+			i = anchor = end;
+		}
+		out = _put_sequence(out, in + anchor, length - anchor, 0, 0);
+		const std::size_t size = out - (unsigned char*)compressed;
+		return size < length ? size : 0;
+	}
+	static std::size_t _bound(const std::size_t length){
+		return length + length / 255 + 16;
+	}
+
+	[[noreturn]] static void _corrupt(const char* reason){
+		throw iGIO::IOfailure(std::string("Error reading: LZ filter ") + reason);
+	}
+	static std::size_t _get_length(const unsigned char*& in, const unsigned char* end, std::size_t length){
+		for(unsigned char byte = 255; byte == 255; length += byte){
+			if(in == end)
+				_corrupt("block is corrupt");
+			byte = *in++;
+		}
+		return length;
+	}
+	static void _decompress(const char* compressed, const std::size_t length, char* block, const std::size_t block_length){
+		const unsigned char* in = (const unsigned char*)compressed;
+		const unsigned char* in_end = in + length;
+		unsigned char* out = (unsigned char*)block;
+		unsigned char* out_end = out + block_length;
+		while(in < in_end){
+			const unsigned char token = *in++;
+			std::size_t literal_length = token >> 4;
+			if(literal_length == 15)
+				literal_length = _get_length(in, in_end, literal_length);
+			if(literal_length > (std::size_t)(in_end - in) || literal_length > (std::size_t)(out_end - out))
+				_corrupt("block is corrupt");
+			std::memcpy(out, in, literal_length);
+			in += literal_length;
+			out += literal_length;
+			if(in == in_end)
+				break;
+			if(in_end - in < 2)
+				_corrupt("block is corrupt");
+			const std::size_t offset = in[0] | (std::size_t)in[1] << 8;
+			in += 2;
+			std::size_t match_length = token & 15;
+			if(match_length == 15)
+				match_length = _get_length(in, in_end, match_length);
+			match_length += min_match;
+			if(!offset || offset > (std::size_t)(out - (unsigned char*)block) || match_length > (std::size_t)(out_end - out))
+				_corrupt("block is corrupt");
+			const unsigned char* match = out - offset;
+			if(offset >= match_length)
+				std::memcpy(out, match, match_length);
+			else // overlapping copy repeats the last offset bytes
+				for(std::size_t i = 0; i < match_length; i++)
+					out[i] = match[i];
+			out += match_length;
+		}
+		if(out != out_end)
+			_corrupt("block is corrupt");
+	}
+
+protected:
+	void write_block(std::vector<char>& raw, stage& next) override{
+		_stored.resize(header_size + _bound(raw.size()));
+		std::size_t size = _level > 0 ? _compress(raw.data(), raw.size(), _stored.data() + header_size) : 0;
+		put_u32(_stored.data(), (std::uint32_t)raw.size());
+		put_u32(_stored.data() + 4, (std::uint32_t)size);
+		if(!size){
+			std::memcpy(_stored.data() + header_size, raw.data(), raw.size());
+			size = raw.size();
+		}
+		next.write(_stored.data(), header_size + size);
+		_stats.raw += raw.size();
+		_stats.stored += header_size + size;
+		_stats.blocks++;
+	}
+
+	// decodes the next block
+	bool read_block(std::vector<char>& block, std::size_t& first, stage& next) override{
+		char header[header_size];
+		const std::size_t n = read_full(next, header, header_size);
+		if(!n)
+			return false;
+		if(n < header_size)
+			_corrupt("block header is truncated");
+		const std::size_t raw_size = get_u32(header), stored_size = get_u32(header + 4);
+		if(!raw_size || raw_size > max_block_size || stored_size >= raw_size) // a block is only stored compressed when it got smaller
+			_corrupt("block header is corrupt");
+		block.resize(raw_size);
+		first = 0;
+		if(!stored_size){ // kept raw
+			if(read_full(next, block.data(), raw_size) != raw_size)
+				_corrupt("block is truncated");
+			return true;
+		}
+		_stored.resize(stored_size);
+		if(read_full(next, _stored.data(), stored_size) != stored_size)
+			_corrupt("block is truncated");
+		_decompress(_stored.data(), stored_size, block.data(), raw_size);
+		return true;
+	}
+public:
+	/**
+	 * @brief Creates a compression filter
+	 * @param level 0 stores blocks raw, 1 is fastest, up to 9 compresses better at lower speed
+	 * @param block_size The amount of bytes compressed together, at most 16 MiB, matches reach back at most 64 KiB
+	 */
+	explicit gio_lz_filter(const int level = 1, const std::size_t block_size = 64 * 1024)
+		: gio_block_filter(std::max<std::size_t>(std::min(block_size, max_block_size), 64)), _level(std::max(0, std::min(level, 9))),
+		  _head(std::size_t(1) << hash_bits), _chain(_level > 1 ? window_mask + 1 : 0) {}
+
+	/**
+	 * @brief The raw and stored byte counts of the blocks written so far, e.g. to report the compression ratio
+	 * @return const stats& The counters
+	 */
+	const stats& statistics() const {
+		return _stats;
+	}
+};
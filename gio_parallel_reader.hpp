@@ -0,0 +1,151 @@
+#pragma once
+#include "GRWI.hpp"
+#include "gio_thread_pool.hpp"
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+/**
+ * @brief Parallel reader splitting the records of an interface across a thread pool
+ * The byte range of the interface is partitioned into chunks whose boundaries are moved to just after the next terminator,
+ * so every record lies in exactly one chunk. Chunks are read with positional reads and parsed on the pool's workers.
+ * Records follow the records() semantics: a record excludes its terminator and the last record does not need to be terminated.
+ * Requires positional access to the interface, the read position of the interface is not used or moved.
+ */
+class gio_parallel_reader {
+public:
+	/**
+	 * @brief A range of whole records, returned by partition()
+	 */
+	struct chunk {
+		std::uint64_t begin;
+		std::uint64_t end;
+	};
+private:
+	iGIO& _igio;
+	const std::string _terminator;
+	gio_thread_pool& _pool;
+
+	// returns the offset after the first terminator ending at or after offset, or end if there is none
+	std::uint64_t _align(const std::uint64_t offset, const std::uint64_t end){
+		const std::size_t block = std::max(_igio.ChunkBytes, _terminator.size() * 2);
+		auto buffer = std::make_unique<char[]>(block);
+		const std::size_t overlap = _terminator.size() - 1;
+		for(std::uint64_t pos = offset - std::min<std::uint64_t>(overlap, offset); pos < end; pos += block - overlap){
+			const std::size_t n = _igio.read_at(pos, buffer.get(), (std::size_t)std::min<std::uint64_t>(block, end - pos));
+			const char* found = iGIO::find_terminator(buffer.get(), buffer.get() + n, _terminator);
+			if(found)
+				return pos + (found - buffer.get()) + _terminator.size();
+			if(pos + n >= end)
+				break;
+		}
+		return end;
+	}
+
+	// calls on_record(record) for every record in the chunk, reading it in ChunkBytes sized positional reads
+	template<typename OnRecord>
+	void _read_chunk(const chunk range, OnRecord&& on_record){
+		std::vector<char> buffer(std::max(_igio.ChunkBytes, _terminator.size() * 2));
+		std::size_t used = 0;
+		for(std::uint64_t pos = range.begin; pos < range.end || used;){
+			if(used == buffer.size()) // a record longer than the buffer
+				buffer.resize(buffer.size() * 2);
+			const std::size_t n = pos < range.end ? _igio.read_at(pos, buffer.data() + used, (std::size_t)std::min<std::uint64_t>(buffer.size() - used, range.end - pos)) : 0;
+			pos += n;
+			const char* first = buffer.data();
+			const char* last = buffer.data() + used + n;
+			for(const char* found; (found = iGIO::find_terminator(first, last, _terminator)); first = found + _terminator.size())
+				on_record(std::string_view(first, found - first));
+			used = last - first;
+			if(!n){ // end of the chunk, the last record of the interface may be unterminated
+				if(used)
+					on_record(std::string_view(first, used));
+				return;
+			}
+			std::memmove(buffer.data(), first, used);
+		}
+	}
+public:
+	/**
+	 * @brief Creates a parallel reader
+	 * @param igio The interface to read, requires positional access
+	 * @param terminator The byte sequence separating records
+	 * @param pool The thread pool to parse on
+	 */
+	gio_parallel_reader(iGIO& igio, std::string_view terminator = "\n", gio_thread_pool& pool = gio_thread_pool::shared())
+		: _igio(igio), _terminator(terminator), _pool(pool) {
+		if(_terminator.empty())
+			throw iGIO::IOfailure("Error reading: parallel reader needs a terminator");
+	}
+
+	/**
+	 * @brief Splits the interface into at most count chunks of about the same size, each boundary just after a terminator
+	 * @param count The amount of chunks, 0 uses one chunk per pool thread
+	 * @return std::vector<chunk> The chunks in order, together covering the whole interface
+	 */
+	std::vector<chunk> partition(std::size_t count = 0){
+		if(!count)
+			count = _pool.size();
+		const std::uint64_t end = _igio.size();
+		std::vector<chunk> chunks;
+		std::uint64_t begin = 0;
+		for(std::size_t i = 1; i <= count && begin < end; i++){
+			std::uint64_t boundary = i == count ? end : end / count * i + end % count * i / count;
+			if(boundary <= begin)
+				continue;
+			if(boundary < end)
+				boundary = _align(boundary, end);
+			chunks.push_back({begin, boundary});
+			begin = boundary;
+		}
+		return chunks;
+	}
+
+	/** @brief Parses every record on the pool and returns one container per chunk
+	 * SUPPORTS: Any container that supports the .push_back() method
+	 * @tparam CT The container type
+	 * @param parse Callable converting a std::string_view record into CT's type
+	 * @param count The amount of chunks, 0 uses one chunk per pool thread
+	 * @return std::vector<CT> The parsed records of every chunk, in file order */
+	template<typename CT, typename Parse>
+	std::vector<CT> read_chunks(Parse&& parse, const std::size_t count = 0){
+		const std::vector<chunk> chunks = partition(count);
+		std::vector<CT> results(chunks.size());
+		_pool.parallel_for(chunks.size(), [&](std::size_t i){
+			_read_chunk(chunks[i], [&](std::string_view record){ results[i].push_back(parse(record)); });
+		});
+		return results;
+	}
+
+	/** @brief Parses every record on the pool and returns the results in file order
+	 * @param parse Callable converting a std::string_view record into the result type
+	 * @param count The amount of chunks, 0 uses one chunk per pool thread
+	 * @return std::vector The parsed records in file order */
+	template<typename Parse>
+	auto read(Parse&& parse, const std::size_t count = 0) -> std::vector<typename std::decay<decltype(parse(std::string_view()))>::type> {
+		using Result = typename std::decay<decltype(parse(std::string_view()))>::type;
+		std::vector<std::vector<Result>> chunks = read_chunks<std::vector<Result>>(parse, count);
+		std::size_t total = 0;
+		for(const auto& results : chunks)
+			total += results.size();
+		std::vector<Result> results;
+		results.reserve(total);
+		for(auto& chunk_results : chunks)
+			std::move(chunk_results.begin(), chunk_results.end(), std::back_inserter(results));
+		return results;
+	}
+
+	/** @brief Calls fn(record, chunk) for every record on the pool, records of one chunk are passed in order by one thread
+	 * @param fn Callable taking a std::string_view record and the std::size_t number of its chunk
+	 * @param count The amount of chunks, 0 uses one chunk per pool thread
+	 * @return std::size_t The amount of chunks */
+	template<typename Fn>
+	std::size_t for_each(Fn&& fn, const std::size_t count = 0){
+		const std::vector<chunk> chunks = partition(count);
+		_pool.parallel_for(chunks.size(), [&](std::size_t i){
+			_read_chunk(chunks[i], [&](std::string_view record){ fn(record, i); });
+		});
+		return chunks.size();
+	}
+};
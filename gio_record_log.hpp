@@ -0,0 +1,226 @@
+#pragma once
+#include "GRWI.hpp"
+
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief Append-only log of records on top of interfaces supporting positional access
+ * Every record is stored in the log as a varint length header followed by the record's bytes.
+ * The start offset of every record is stored in a separate index interface as native std::uint64_t values,
+ * which makes read_record(n) a single positional read of the log.
+ * The index is loaded on first use. Records missing from the index, e.g. after a crash, are recovered by scanning the log,
+ * a torn record at the end of the log is overwritten by the next write.
+ * Once the index is loaded, e.g. by count(), read_record() can be called from multiple threads at once.
+ */
+class gio_record_log {
+private:
+	iGIO& _log;
+	iGIO& _index;
+	std::vector<std::uint64_t> _offsets; // start offset of every record in the log
+	std::uint64_t _end = 0; // end offset of the last complete record
+	bool _loaded = false;
+	std::vector<char> _staging; // header and bytes of the record being written
+
+	static constexpr std::size_t max_header = 10; // varint of a 64 bit length
+
+	static std::size_t _encode_header(char* out, std::uint64_t length){
+		std::size_t n = 0;
+		for(; length >= 0x80; length >>= 7)
+			out[n++] = (char)(length | 0x80);
+		out[n++] = (char)length;
+		return n;
+	}
+	// returns the size of the header, 0 if the header is incomplete
+	static std::size_t _decode_header(const char* in, const std::size_t available, std::uint64_t& length){
+		length = 0;
+		for(std::size_t n = 0; n < available && n < max_header; n++){
+			length |= (std::uint64_t)(in[n] & 0x7F) << (7 * n);
+			if(!(in[n] & 0x80))
+				return n + 1;
+		}
+		return 0;
+	}
+
+	void _append_index(const std::uint64_t offset){
+		_index.write_at(_offsets.size() * sizeof(std::uint64_t), offset);
+		_offsets.push_back(offset);
+	}
+
+	void _load(){
+		if(_loaded)
+			return;
+		_offsets.resize(_index.size() / sizeof(std::uint64_t));
+		_offsets.resize(_index.read_at(0, _offsets.data(), _offsets.size()));
+		const std::uint64_t log_size = _log.size();
+		while(!_offsets.empty() && _offsets.back() >= log_size) // the log was truncated
+			_offsets.pop_back();
+
+		// validate the last indexed record and index the records written after it
+		std::size_t next = _offsets.empty() ? 0 : _offsets.size() - 1; // the record starting at _end
+		_end = _offsets.empty() ? 0 : _offsets.back();
+		while(_end < log_size){
+			char header[max_header];
+			std::uint64_t length = 0;
+			std::size_t n = _log.read_at(_end, header, (std::size_t)std::min<std::uint64_t>(max_header, log_size - _end));
+			std::size_t header_size = _decode_header(header, n, length);
+			if(!header_size || length > log_size - _end - header_size) // torn record
+				break;
+			if(next == _offsets.size())
+				_append_index(_end);
+			next++;
+			_end += header_size + length;
+		}
+		_offsets.resize(next);
+		_loaded = true;
+	}
+
+	//* record serialization, appends the bytes of the record to _staging
+	void _append(const char* data, const std::size_t length){
+		_staging.insert(_staging.end(), data, data + length);
+	}
+	template<typename Type> typename std::enable_if<
+		iGIO::is_flat<Type>::value && !iGIO::is_contiguous_leaf<Type>::value,
+	void>::type			_append_record(const Type& record) { _append((const char*)&record, sizeof(Type)); }
+	void				_append_record(const iIOable& record) {
+		_staging.resize(_staging.size() + record.ObjectByteSize());
+		record.copyBytes(_staging.data() + _staging.size() - record.ObjectByteSize());
+	}
+	void				_append_record(const char* record) { _append(record, std::strlen(record)); }
+	template<typename CT> typename std::enable_if<
+		iGIO::is_contiguous_leaf<CT>::value,
+	void>::type			_append_record(const CT& record) { _append((const char*)record.data(), record.size() * sizeof(iGIO::CElemType<CT>)); }
+	template<typename CharT, typename Traits>
+	void				_append_record(std::basic_string_view<CharT, Traits> record) { _append((const char*)record.data(), record.size() * sizeof(CharT)); }
+	template<typename CT> typename std::enable_if<
+		iGIO::is_container<CT>::value && !iGIO::is_container_adapter<CT>::value && !iGIO::is_contiguous_leaf<CT>::value && !iGIO::is_string_view<CT>::value && iGIO::is_flat<iGIO::CElemType<CT>>::value,
+	void>::type			_append_record(const CT& record) {
+		for(const auto& element : record)
+			_append((const char*)&element, sizeof(element));
+	}
+
+	// reads record n with a single positional read, returns a view of its bytes in buffer
+	std::string_view _read_record(const std::size_t n, std::vector<char>& buffer){
+		_load();
+		if(n >= _offsets.size())
+			throw iGIO::IOfailure("Error reading record: record " + std::to_string(n) + " does not exist, the log has " + std::to_string(_offsets.size()) + " records");
+		const std::uint64_t begin = _offsets[n], end = n + 1 < _offsets.size() ? _offsets[n + 1] : _end;
+		buffer.resize(end - begin);
+		if(_log.read_at(begin, buffer.data(), buffer.size()) != buffer.size())
+			throw iGIO::IOfailure("Error reading record: record " + std::to_string(n) + " is incomplete");
+		std::uint64_t length = 0;
+		std::size_t header_size = _decode_header(buffer.data(), buffer.size(), length);
+		if(!header_size || header_size + length != buffer.size())
+			throw iGIO::IOfailure("Error reading record: record " + std::to_string(n) + " has a corrupt header");
+		return std::string_view(buffer.data() + header_size, length);
+	}
+	static void _check_size(const std::size_t n, const std::size_t size, const std::size_t expected){
+		if(size != expected)
+			throw iGIO::IOfailure("Error reading record: record " + std::to_string(n) + " has " + std::to_string(size) + " bytes, expected " + std::to_string(expected));
+	}
+	static std::vector<char>& _read_buffer(){
+		thread_local std::vector<char> buffer;
+		return buffer;
+	}
+public:
+	/**
+	 * @brief Opens a record log
+	 * @param log The interface storing the records, requires positional access
+	 * @param index The interface storing the record offsets, requires positional access
+	 */
+	gio_record_log(iGIO& log, iGIO& index) : _log(log), _index(index) {}
+
+	/**
+	 * @brief The amount of records in the log, loads the index if it was not loaded yet
+	 * @return std::size_t The amount of records
+	 */
+	std::size_t count(){
+		_load();
+		return _offsets.size();
+	}
+
+	/** @brief Appends a record to the log and its offset to the index
+	 * SUPPORTS: types that can be sent as raw bytes, iIOable, strings, string views and containers of types that can be sent as raw bytes
+	 * @tparam Type The type of the record
+	 * @param record The record to append
+	 * @return std::size_t The number of the record written */
+	template<typename Type>
+	std::size_t write(const Type& record){
+		_load();
+		_staging.resize(max_header); // room to prepend the header once the length is known
+		_append_record(record);
+		char header[max_header];
+		const std::size_t header_size = _encode_header(header, _staging.size() - max_header);
+		char* data = _staging.data() + max_header - header_size;
+		std::memcpy(data, header, header_size);
+		const std::size_t length = _staging.size() - max_header + header_size;
+		if(_log.write_at(_end, data, length) != length)
+			throw iGIO::IOfailure("Error writing record: record " + std::to_string(_offsets.size()) + " was not written completely");
+		_append_index(_end); // the index is written after the record, a crash in between is recovered by _load()
+		_end += length;
+		return _offsets.size() - 1;
+	}
+
+	/** @brief Reads the bytes of record n with a single positional read
+	 * @param n The number of the record
+	 * @return std::string The bytes of the record */
+	std::string read_record(const std::size_t n){
+		return std::string(_read_record(n, _read_buffer()));
+	}
+
+	/** @brief Reads record n into a value with a single positional read, throws IOfailure if the record has a different size
+	 * SUPPORTS: types that can be sent as raw bytes and iIOable
+	 * @tparam Type The type of the record
+	 * @param n The number of the record
+	 * @param record The value to read into
+	 * @return std::size_t The amount of Type read, 1 */
+	template<typename Type> typename std::enable_if<
+		iGIO::is_flat<Type>::value && !iGIO::is_contiguous_leaf<Type>::value,
+	std::size_t>::type	read_record(const std::size_t n, Type& record) {
+		std::string_view bytes = _read_record(n, _read_buffer());
+		_check_size(n, bytes.size(), sizeof(Type));
+		std::memcpy((char*)&record, bytes.data(), sizeof(Type));
+		return 1;
+	}
+	std::size_t			read_record(const std::size_t n, iIOable& record) {
+		std::string_view bytes = _read_record(n, _read_buffer());
+		_check_size(n, bytes.size(), record.ObjectByteSize());
+		record.fromBytes(bytes.data());
+		return 1;
+	}
+
+	/** @brief Reads record n into a container with a single positional read, replacing its contents
+	 * SUPPORTS: std::vector, std::array, std::basic_string and push_back containers of types that can be sent as raw bytes
+	 * @tparam CT The container type
+	 * @param n The number of the record
+	 * @param record The container to read into
+	 * @return std::size_t The amount of CT's type read */
+	template<typename CT> typename std::enable_if<
+		iGIO::is_contiguous_leaf<CT>::value,
+	std::size_t>::type	read_record(const std::size_t n, CT& record) {
+		std::string_view bytes = _read_record(n, _read_buffer());
+		const std::size_t count = bytes.size() / sizeof(iGIO::CElemType<CT>);
+		if constexpr(iGIO::is_flat<CT>::value) // std::array
+			_check_size(n, bytes.size(), sizeof(CT));
+		else{
+			_check_size(n, bytes.size(), count * sizeof(iGIO::CElemType<CT>));
+			record.resize(count);
+		}
+		std::memcpy((char*)record.data(), bytes.data(), bytes.size());
+		return count;
+	}
+	template<typename CT> typename std::enable_if<
+		iGIO::is_container<CT>::value && iGIO::has_pushback<CT>::value && !iGIO::is_contiguous_leaf<CT>::value && iGIO::is_flat<iGIO::CElemType<CT>>::value,
+	std::size_t>::type	read_record(const std::size_t n, CT& record) {
+		std::string_view bytes = _read_record(n, _read_buffer());
+		const std::size_t count = bytes.size() / sizeof(iGIO::CElemType<CT>);
+		_check_size(n, bytes.size(), count * sizeof(iGIO::CElemType<CT>));
+		record.clear();
+		for(std::size_t i = 0; i < count; i++){
+			iGIO::CElemType<CT> element;
+			std::memcpy((char*)&element, bytes.data() + i * sizeof(element), sizeof(element));
+			record.push_back(element);
+		}
+		return count;
+	}
+};
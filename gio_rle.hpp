@@ -0,0 +1,237 @@
+#pragma once
+#include "gio_varint.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Run length and sparse coding of blocks of fixed size elements, see iGIO::write_rle()
+ * A block is stored raw, as runs of varint length and element, or sparse as the varint count of nonzero elements
+ * followed by varint gap and element pairs. scan() measures a block's zero and repeat density, choose() picks the
+ * smallest of the three codings from it. Decoding fills runs and zeroed blocks with memset like fills.
+ */
+struct gio_rle {
+	enum mode : std::uint8_t { raw = 0, runs = 1, sparse = 2 };
+
+	/**
+	 * @brief Zero and repeat density of a block
+	 */
+	struct density {
+		std::size_t nonzero = 0;	// elements with a nonzero byte
+		std::size_t runs = 0;		// runs of equal elements
+	};
+
+	/**
+	 * @brief Counts the nonzero elements and the runs of a block, 16 bytes at a time with SSE2 for element sizes dividing 16
+	 * @param data The elements
+	 * @param count The amount of elements
+	 * @param size The size of an element in bytes
+	 * @return density The counts
+	 */
+	static density scan(const char* data, const std::size_t count, const std::size_t size){
+		density d;
+		if(!count)
+			return d;
+		std::size_t zero = 0, equal_next = 0, e = 0;
+#if defined(__SSE2__) && defined(__GNUC__)
+		switch(size){
+			case 1: e = _scan_sse2<1>(data, count, zero, equal_next); break;
+			case 2: e = _scan_sse2<2>(data, count, zero, equal_next); break;
+			case 4: e = _scan_sse2<4>(data, count, zero, equal_next); break;
+			case 8: e = _scan_sse2<8>(data, count, zero, equal_next); break;
+			case 16: e = _scan_sse2<16>(data, count, zero, equal_next); break;
+		}
+#endif
+		for(; e < count; e++){
+			const char* element = data + e * size;
+			zero += _is_zero(element, size);
+			equal_next += e + 1 < count && !std::memcmp(element, element + size, size);
+		}
+		d.nonzero = count - zero;
+		d.runs = count - equal_next;
+		return d;
+	}
+
+	/**
+	 * @brief Picks the coding storing a block in the fewest bytes, estimating one byte per varint
+	 */
+	static mode choose(const density& d, const std::size_t count, const std::size_t size){
+		const std::size_t raw_bytes = count * size;
+		const std::size_t run_bytes = d.runs * (size + 1);
+		const std::size_t sparse_bytes = d.nonzero * (size + 1) + 1;
+		if(run_bytes < raw_bytes && run_bytes <= sparse_bytes)
+			return runs;
+		if(sparse_bytes < raw_bytes)
+			return sparse;
+		return raw;
+	}
+
+	/**
+	 * @brief The most bytes encode() writes for a block
+	 */
+	static std::size_t max_encoded(const std::size_t count, const std::size_t size){
+		return count * (size + gio_varint::max_bytes) + gio_varint::max_bytes;
+	}
+
+	/**
+	 * @brief Encodes a block
+	 * @param m The coding, see choose()
+	 * @param d The density of the block, see scan()
+	 * @param data The elements
+	 * @param count The amount of elements
+	 * @param size The size of an element in bytes
+	 * @param out Room for max_encoded() bytes
+	 * @return std::size_t The amount of bytes written to out
+	 */
+	static std::size_t encode(const mode m, const density& d, const char* data, const std::size_t count, const std::size_t size, char* out){
+		char* o = out;
+		if(m == raw){
+			std::memcpy(o, data, count * size);
+			return count * size;
+		}
+		if(m == runs){
+			for(std::size_t e = 0; e < count;){
+				const std::size_t next = _run_end(data, e, count, size);
+				o += gio_varint::encode(next - e, o);
+				std::memcpy(o, data + e * size, size);
+				o += size;
+				e = next;
+			}
+			return o - out;
+		}
+		o += gio_varint::encode(d.nonzero, o);
+		for(std::size_t e = _next_nonzero(data, 0, count, size), expected = 0; e < count; e = _next_nonzero(data, e + 1, count, size)){
+			o += gio_varint::encode(e - expected, o);
+			std::memcpy(o, data + e * size, size);
+			o += size;
+			expected = e + 1;
+		}
+		return o - out;
+	}
+
+	/**
+	 * @brief Decodes a block written by encode()
+	 * @param m The coding of the block
+	 * @param in The encoded bytes
+	 * @param length The amount of encoded bytes
+	 * @param out Room for count elements
+	 * @param count The amount of elements of the block
+	 * @param size The size of an element in bytes
+	 * @return bool false if the encoded bytes are corrupt
+	 */
+	static bool decode(const mode m, const char* in, const std::size_t length, char* out, const std::size_t count, const std::size_t size){
+		const char* const end = in + length;
+		std::uint64_t value;
+		if(m == raw){
+			if(length != count * size)
+				return false;
+			std::memcpy(out, in, length);
+			return true;
+		}
+		if(m == runs){
+			for(std::size_t filled = 0; filled < count; filled += (std::size_t)value){
+				if(!gio_varint::decode(in, end, &value, 1) || !value || value > count - filled || (std::size_t)(end - in) < size)
+					return false;
+				fill(out + filled * size, in, (std::size_t)value, size);
+				in += size;
+			}
+			return in == end;
+		}
+		if(m != sparse || !gio_varint::decode(in, end, &value, 1) || value > count)
+			return false;
+		std::memset(out, 0, count * size);
+		for(std::uint64_t i = 0, expected = 0, nonzero = value; i < nonzero; i++){
+			if(!gio_varint::decode(in, end, &value, 1) || value >= count - expected || (std::size_t)(end - in) < size)
+				return false;
+			expected += value;
+			std::memcpy(out + expected * size, in, size);
+			in += size;
+			expected++;
+		}
+		return in == end;
+	}
+
+	/**
+	 * @brief Fills count elements with one element, with memset when all its bytes are equal and by doubling copies otherwise
+	 */
+	static void fill(char* out, const char* element, const std::size_t count, const std::size_t size){
+		if(!count)
+			return;
+		if(std::all_of(element, element + size, [element](char c){ return c == element[0]; }))
+			return (void)std::memset(out, element[0], count * size);
+		std::memcpy(out, element, size);
+		for(std::size_t filled = size, total = count * size; filled < total; filled *= 2)
+			std::memcpy(out + filled, out, std::min(filled, total - filled));
+	}
+private:
+	static bool _is_zero(const char* element, const std::size_t size){
+		for(std::size_t i = 0; i < size; i++)
+			if(element[i])
+				return false;
+		return true;
+	}
+	static std::uint64_t _word(const char* p){
+		std::uint64_t word;
+		std::memcpy(&word, p, sizeof(word));
+		return word;
+	}
+	// the first element from e on with a nonzero byte, skipping zero bytes 8 at a time
+	static std::size_t _next_nonzero(const char* data, std::size_t e, const std::size_t count, const std::size_t size){
+		std::size_t byte = e * size;
+		while(byte + 8 <= count * size && !_word(data + byte))
+			byte += 8;
+		for(e = std::max(e, byte / size); e < count && _is_zero(data + e * size, size); e++);
+		return e;
+	}
+	// the first element after e that differs from element e, the run continues while every byte equals the byte size bytes before it
+	static std::size_t _run_end(const char* data, const std::size_t e, const std::size_t count, const std::size_t size){
+		const char* p = data + e * size;
+		const std::size_t length = (count - e - 1) * size; // bytes after element e
+		std::size_t i = 0;
+		while(i + 8 <= length && _word(p + i) == _word(p + i + size))
+			i += 8;
+		while(i < length && p[i] == p[i + size])
+			i++;
+		return e + 1 + i / size;
+	}
+#if defined(__SSE2__) && defined(__GNUC__)
+	// counts the zero elements and the elements equal to the next one 16 bytes at a time, returns the first element left to count
+	template<std::size_t Size>
+	static std::size_t _scan_sse2(const char* data, const std::size_t count, std::size_t& zero, std::size_t& equal_next){
+		constexpr std::size_t per_vector = 16 / Size;
+		unsigned first_bytes = 0; // the bit of the first byte of every element in a byte mask
+		for(std::size_t i = 0; i < 16; i += Size)
+			first_bytes |= 1u << i;
+		const __m128i zeros = _mm_setzero_si128();
+		std::size_t e = 0;
+		for(; (e + 1) * Size + 16 <= count * Size; e += per_vector){ // the next elements are loaded one element further
+			const __m128i v = _mm_loadu_si128((const __m128i*)(data + e * Size));
+			const __m128i next = _mm_loadu_si128((const __m128i*)(data + (e + 1) * Size));
+			const unsigned zero_bytes = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, zeros));
+			const unsigned equal_bytes = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, next));
+			if((zero_bytes & equal_bytes) == 0xFFFF){ // inside a run of zeros
+				zero += per_vector;
+				equal_next += per_vector;
+				continue;
+			}
+			zero += (std::size_t)__builtin_popcount(_whole_elements<Size>(zero_bytes) & first_bytes);
+			equal_next += (std::size_t)__builtin_popcount(_whole_elements<Size>(equal_bytes) & first_bytes);
+		}
+		return e;
+	}
+	// sets the bit of the first byte of an element when the bits of all its bytes are set
+	template<std::size_t Size>
+	static unsigned _whole_elements(const unsigned bytes){
+		unsigned all = bytes;
+		for(std::size_t shift = 1; shift < Size; shift++)
+			all &= bytes >> shift;
+		return all;
+	}
+#endif
+};
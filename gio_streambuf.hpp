@@ -0,0 +1,116 @@
+#pragma once
+#include "GRWI.hpp"
+
+#include <streambuf>
+#include <iostream>
+
+/**
+ * @brief std::streambuf adapter over an interface, lets any iGIO be used as a buffered std::iostream
+ * EXAMPLE: gio_streambuf buf(file); std::ostream os(&buf); os << 42 << std::endl;
+ * Output is buffered until the put area is full or the stream is flushed, flushing also flushes the interface.
+ * Input is read ahead into the get area, unread input is returned to the interface when the adapter is destroyed.
+ * Transfers larger than the buffer bypass it and go to the interface directly.
+ */
+class gio_streambuf : public std::streambuf {
+private:
+	iGIO& _igio;
+	std::size_t _buffer_size;
+	std::unique_ptr<char[]> _gbuf;
+	std::unique_ptr<char[]> _pbuf;
+
+	// writes the put area to the interface
+	bool _flush_put(){
+		std::size_t pending = pptr() - pbase();
+		if(pending && _igio._write(pbase(), pending) != pending)
+			return false;
+		setp(_pbuf.get(), _pbuf.get() + _buffer_size);
+		return true;
+	}
+protected:
+	virtual int_type overflow(int_type ch) override{
+		if(!_flush_put())
+			return traits_type::eof();
+		if(!traits_type::eq_int_type(ch, traits_type::eof())){
+			*pptr() = traits_type::to_char_type(ch);
+			pbump(1);
+		}
+		return traits_type::not_eof(ch);
+	}
+
+	virtual std::streamsize xsputn(const char* s, std::streamsize count) override{
+		if((std::size_t)count <= (std::size_t)(epptr() - pptr())){ // fits in the put area
+			std::memcpy(pptr(), s, count);
+			pbump((int)count);
+			return count;
+		}
+		if(!_flush_put())
+			return 0;
+		if((std::size_t)count >= _buffer_size) // large writes bypass the put area
+			return _igio._write(s, count);
+		std::memcpy(pptr(), s, count);
+		pbump((int)count);
+		return count;
+	}
+
+	virtual int sync() override{
+		if(!_flush_put())
+			return -1;
+		iGIO::flush(_igio);
+		return 0;
+	}
+
+	virtual int_type underflow() override{
+		if(gptr() < egptr())
+			return traits_type::to_int_type(*gptr());
+		std::size_t n = _igio._read(_gbuf.get(), _buffer_size);
+		if(!n)
+			return traits_type::eof();
+		setg(_gbuf.get(), _gbuf.get(), _gbuf.get() + n);
+		return traits_type::to_int_type(*gptr());
+	}
+
+	virtual std::streamsize xsgetn(char* s, std::streamsize count) override{
+		std::streamsize copied = std::min<std::streamsize>(count, egptr() - gptr());
+		std::memcpy(s, gptr(), copied);
+		gbump((int)copied);
+		while(copied < count){
+			std::size_t remaining = count - copied;
+			if(remaining >= _buffer_size){ // large reads bypass the get area
+				std::size_t n = _igio._read(s + copied, remaining);
+				if(!n)
+					break;
+				copied += n;
+				continue;
+			}
+			if(traits_type::eq_int_type(underflow(), traits_type::eof()))
+				break;
+			std::streamsize n = std::min<std::streamsize>(remaining, egptr() - gptr());
+			std::memcpy(s + copied, gptr(), n);
+			gbump((int)n);
+			copied += n;
+		}
+		return copied;
+	}
+public:
+	/**
+	 * @brief Construct a new gio streambuf object
+	 * @param igio The interface to read from and write to
+	 * @param buffer_size The size of the get and put areas in bytes
+	 */
+	explicit gio_streambuf(iGIO& igio, std::size_t buffer_size = 64 * 1024) 
+		: _igio(igio), _buffer_size(std::max<std::size_t>(buffer_size, 1)),
+		  _gbuf(std::make_unique<char[]>(_buffer_size)), _pbuf(std::make_unique<char[]>(_buffer_size)) {
+		setg(_gbuf.get(), _gbuf.get(), _gbuf.get());
+		setp(_pbuf.get(), _pbuf.get() + _buffer_size);
+	}
+
+	gio_streambuf(const gio_streambuf&) = delete;
+	gio_streambuf& operator=(const gio_streambuf&) = delete;
+
+	virtual ~gio_streambuf(){
+		try{
+			_flush_put();
+		} catch(const iGIO::IOfailure&){} // destructors must not throw, call pubsync() to observe write errors
+		_igio._unread(gptr(), egptr() - gptr());
+	}
+};
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <algorithm>
+
+/**
+ * @brief Fixed size pool of worker threads used by the parallel readers and encoders
+ * Tasks are run in submission order, the destructor finishes all queued tasks before joining the workers.
+ */
+class gio_thread_pool {
+private:
+	std::vector<std::thread> _workers;
+	std::deque<std::function<void()>> _tasks;
+	std::mutex _mutex;
+	std::condition_variable _cv;
+	bool _stop = false;
+
+	void _work(){
+		for(;;){
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_cv.wait(lock, [&]{ return _stop || !_tasks.empty(); });
+				if(_tasks.empty())
+					return;
+				task = std::move(_tasks.front());
+				_tasks.pop_front();
+			}
+			task();
+		}
+	}
+
+	void _enqueue(std::function<void()> task){
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_tasks.push_back(std::move(task));
+		}
+		_cv.notify_one();
+	}
+public:
+	/**
+	 * @brief Starts the worker threads
+	 * @param threads The amount of workers, 0 uses one per hardware thread
+	 */
+	explicit gio_thread_pool(std::size_t threads = 0){
+		if(!threads)
+			threads = std::max(1u, std::thread::hardware_concurrency());
+		_workers.reserve(threads);
+		for(std::size_t i = 0; i < threads; i++)
+			_workers.emplace_back([this]{ _work(); });
+	}
+	gio_thread_pool(const gio_thread_pool&) = delete;
+	gio_thread_pool& operator=(const gio_thread_pool&) = delete;
+	~gio_thread_pool(){
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stop = true;
+		}
+		_cv.notify_all();
+		for(auto& worker : _workers)
+			worker.join();
+	}
+
+	/**
+	 * @brief The amount of worker threads
+	 */
+	std::size_t size() const {
+		return _workers.size();
+	}
+
+	/**
+	 * @brief The pool shared by the library's parallel functions, started on first use with one worker per hardware thread
+	 */
+	static gio_thread_pool& shared(){
+		static gio_thread_pool pool;
+		return pool;
+	}
+
+	/**
+	 * @brief Runs a task on a worker thread
+	 * @tparam Task A callable without arguments
+	 * @return std::future The result of the task, exceptions are rethrown by get()
+	 */
+	template<typename Task>
+	auto submit(Task&& task) -> std::future<decltype(task())> {
+		auto packaged = std::make_shared<std::packaged_task<decltype(task())()>>(std::forward<Task>(task));
+		auto result = packaged->get_future();
+		_enqueue([packaged]{ (*packaged)(); });
+		return result;
+	}
+
+	/**
+	 * @brief Calls body(i) for every i in [0, count) on the workers and the calling thread, returning when all calls finished
+	 * The calling thread takes part, so parallel_for can be nested inside tasks of the same pool.
+	 * The first exception thrown by body is rethrown after all calls finished.
+	 * @param count The amount of calls
+	 * @param body A callable taking a std::size_t index
+	 */
+	template<typename Body>
+	void parallel_for(const std::size_t count, Body&& body){
+		if(count <= 1 || size() == 0){
+			for(std::size_t i = 0; i < count; i++)
+				body(i);
+			return;
+		}
+		struct state {
+			std::atomic<std::size_t> next{0};
+			std::size_t done = 0;
+			std::exception_ptr error;
+			std::mutex mutex;
+			std::condition_variable cv;
+		};
+		auto shared = std::make_shared<state>();
+		auto run = [shared, count, &body]{
+			for(std::size_t i; (i = shared->next.fetch_add(1)) < count; ){
+				std::exception_ptr error;
+				try{
+					body(i);
+				} catch(...){
+					error = std::current_exception();
+				}
+				std::lock_guard<std::mutex> lock(shared->mutex);
+				if(error && !shared->error)
+					shared->error = error;
+				if(++shared->done == count)
+					shared->cv.notify_all();
+			}
+		};
+		// helpers that start after all indices are taken return without touching body
+		for(std::size_t i = 0, helpers = std::min(size(), count - 1); i < helpers; i++)
+			_enqueue(run);
+		run();
+		std::unique_lock<std::mutex> lock(shared->mutex);
+		shared->cv.wait(lock, [&]{ return shared->done == count; });
+		if(shared->error)
+			std::rethrow_exception(shared->error);
+	}
+};
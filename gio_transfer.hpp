@@ -0,0 +1,227 @@
+#pragma once
+#include "GRWI.hpp"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <cerrno>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/sendfile.h>
+#endif
+
+/**
+ * @brief Interface to interface transfer engine
+ * When both interfaces expose file descriptors the data is copied by the kernel with copy_file_range, sendfile or splice,
+ * otherwise the source is read on a separate thread into one buffer while the previous buffer is written to the destination.
+ * Data the source has already read ahead, e.g. by records(), is written first.
+ */
+class gio_transfer {
+private:
+	static constexpr std::size_t kernel_chunk = std::size_t(1) << 30; // maximum amount of bytes per system call
+
+	// writes the data the source has already read ahead to the destination
+	static std::size_t _drain(iGIO& src, iGIO& dst, const std::size_t bytes){
+		std::size_t n = src._rbuf_end - src._rbuf_begin;
+		if(bytes)
+			n = std::min(n, bytes);
+		if(!n)
+			return 0;
+		const char* data = src._rbuf.get() + src._rbuf_begin;
+		src._rbuf_begin += n;
+		return dst._write(data, n);
+	}
+
+#ifdef __linux__
+	enum class kernel_copy { copy_file_range, sendfile, splice };
+
+	static bool _is_pipe(int fd){
+		struct stat st;
+		return ::fstat(fd, &st) == 0 && S_ISFIFO(st.st_mode);
+	}
+
+	/// Whether both descriptors refer to the same file
+	static bool _same_file(int in, int out){
+		struct stat a, b;
+		return ::fstat(in, &a) == 0 && ::fstat(out, &b) == 0 && a.st_dev == b.st_dev && a.st_ino == b.st_ino;
+	}
+
+	/// The amount of bytes between the read offset of the descriptor and the end of its file
+	static std::size_t _unread(int fd){
+		struct stat st;
+		const off_t offset = ::lseek(fd, 0, SEEK_CUR);
+		if(::fstat(fd, &st) != 0 || offset < 0 || st.st_size <= offset)
+			return 0;
+		return st.st_size - offset;
+	}
+
+	/**
+	 * @brief Copies between two file descriptors inside the kernel until bytes are copied or the source is exhausted
+	 * @param copied The amount of bytes copied
+	 * @return bool false if the method is not supported for these descriptors, nothing has been copied in that case
+	 */
+	static bool _copy_kernel(const kernel_copy method, const int in, const int out, const std::size_t bytes, std::size_t& copied){
+		if(method == kernel_copy::splice && !_is_pipe(in) && !_is_pipe(out)) // splice needs a pipe on one side
+			return false;
+		for(;;){
+			const std::size_t length = bytes ? std::min(bytes - copied, kernel_chunk) : kernel_chunk;
+			if(!length)
+				return true;
+			ssize_t n = 0;
+			switch(method){
+				case kernel_copy::copy_file_range: n = ::copy_file_range(in, nullptr, out, nullptr, length, 0); break;
+				case kernel_copy::sendfile:		   n = ::sendfile(out, in, nullptr, length); break;
+				case kernel_copy::splice:		   n = ::splice(in, nullptr, out, nullptr, length, SPLICE_F_MOVE); break;
+			}
+			if(n < 0 && errno == EINTR)
+				continue;
+			if(n < 0 && !copied && (errno == EXDEV || errno == EINVAL || errno == ENOSYS || errno == EOPNOTSUPP || errno == EBADF || errno == ESPIPE))
+				return false;
+			if(n < 0)
+				throw iGIO::IOfailure(std::string("Error transferring: ") + std::strerror(errno));
+			if(n == 0)
+				return true;
+			copied += n;
+		}
+	}
+#endif
+
+	// copies through user space without a second thread, for small transfers or when source and destination are the same interface
+	static std::size_t _copy_serial(iGIO& src, iGIO& dst, const std::size_t bytes){
+		const std::size_t chunk = std::max<std::size_t>(src.ChunkBytes, 1);
+		auto buffer = std::make_unique<char[]>(bytes ? std::min(chunk, bytes) : chunk);
+		std::size_t copied = 0;
+		for(;;){
+			const std::size_t length = bytes ? std::min(chunk, bytes - copied) : chunk;
+			const std::size_t n = length ? src._read(buffer.get(), length) : 0;
+			if(!n)
+				return copied;
+			copied += dst._write(buffer.get(), n);
+		}
+	}
+
+	// copies through two buffers, the source fills one buffer on a reader thread while the other is written to the destination
+	static std::size_t _copy_pipelined(iGIO& src, iGIO& dst, const std::size_t bytes){
+		const std::size_t chunk = std::max<std::size_t>(src.ChunkBytes, 1);
+		std::unique_ptr<char[]> buffers[2] = {std::make_unique<char[]>(chunk), std::make_unique<char[]>(chunk)};
+		std::size_t lengths[2] = {0, 0};
+		bool full[2] = {false, false};
+		bool abort = false;
+		std::exception_ptr read_error;
+		std::mutex mutex;
+		std::condition_variable cv;
+
+		std::thread reader([&]{
+			std::size_t requested = 0;
+			for(std::size_t slot = 0;; slot ^= 1){
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					cv.wait(lock, [&]{ return !full[slot] || abort; });
+					if(abort)
+						return;
+				}
+				std::size_t n = 0;
+				try{
+					const std::size_t length = bytes ? std::min(chunk, bytes - requested) : chunk;
+					n = length ? src._read(buffers[slot].get(), length) : 0;
+				} catch(...){
+					read_error = std::current_exception();
+					n = 0;
+				}
+				requested += n;
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					lengths[slot] = n;
+					full[slot] = true;
+				}
+				cv.notify_all();
+				if(!n) // end of data or error, signalled to the writer by an empty buffer
+					return;
+			}
+		});
+
+		std::size_t copied = 0;
+		try{
+			for(std::size_t slot = 0;; slot ^= 1){
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					cv.wait(lock, [&]{ return full[slot]; });
+				}
+				if(!lengths[slot])
+					break;
+				copied += dst._write(buffers[slot].get(), lengths[slot]);
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					full[slot] = false;
+				}
+				cv.notify_all();
+			}
+		} catch(...){
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				abort = true;
+			}
+			cv.notify_all();
+			reader.join();
+			throw;
+		}
+		reader.join();
+		if(read_error)
+			std::rethrow_exception(read_error);
+		return copied;
+	}
+public:
+	/**
+	 * @brief Copies data from the source interface to the destination interface
+	 * Uses copy_file_range, sendfile or splice when both interfaces expose file descriptors and the kernel supports it for them,
+	 * otherwise a double buffered copy through user space.
+	 * Throws IOfailure if reading or writing fails.
+	 * @param src The interface to read from
+	 * @param dst The interface to write to
+	 * @param bytes The amount of bytes to copy, 0 copies until the source has no data available,
+	 * or when both sides are the same file, the data present when the copy starts
+	 * @return std::size_t The amount of bytes copied
+	 */
+	static std::size_t copy(iGIO& src, iGIO& dst, const std::size_t bytes = 0){
+		std::size_t copied = _drain(src, dst, bytes);
+		if(bytes && copied >= bytes)
+			return copied;
+		std::size_t remaining = bytes ? bytes - copied : 0;
+		bool same = &src == &dst;
+#ifdef __linux__
+		const int in = src.iReadFd(), out = dst.iWriteFd();
+		if(in >= 0 && out >= 0)
+			same = same || _same_file(in, out);
+		if(same && !remaining && in >= 0){ // the writes grow the file being read, copy only what is there now instead of chasing its end
+			remaining = _unread(in);
+			if(!remaining)
+				return copied;
+		}
+		if(!same && in >= 0 && out >= 0 && src._filters.empty() && dst._filters.empty()){ // the kernel would bypass the filters
+			for(kernel_copy method : {kernel_copy::copy_file_range, kernel_copy::sendfile, kernel_copy::splice}){
+				std::size_t kernel_copied = 0;
+				if(_copy_kernel(method, in, out, remaining, kernel_copied))
+					return copied + kernel_copied;
+			}
+		}
+#endif
+		if(same || (remaining && remaining <= src.ChunkBytes))
+			return copied + _copy_serial(src, dst, remaining);
+		return copied + _copy_pipelined(src, dst, remaining);
+	}
+};
+
+/**
+ * @brief Copies data from the source interface to the destination interface, see gio_transfer::copy()
+ * @param src The interface to read from
+ * @param dst The interface to write to
+ * @param bytes The amount of bytes to copy, 0 copies until the source has no data available
+ * @return std::size_t The amount of bytes copied
+ */
+inline std::size_t transfer(iGIO& src, iGIO& dst, const std::size_t bytes = 0){
+	return gio_transfer::copy(src, dst, bytes);
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief LEB128 variable length integers, with zigzag and delta coding, see iGIO::write_varint()
+ * A value is stored in 7 bit groups, lowest first, every byte except the last has its top bit set.
+ * Zigzag coding maps signed values to unsigned ones so small negative numbers stay short,
+ * delta coding stores the difference to the previous value so slowly changing sequences stay short.
+ */
+struct gio_varint {
+	// the longest encoding of a 64 bit value
+	static constexpr std::size_t max_bytes = 10;
+
+	/**
+	 * @brief Encodes a value
+	 * @param value The value to encode
+	 * @param out Room for at least max_bytes bytes
+	 * @return std::size_t The amount of bytes written to out
+	 */
+	static std::size_t encode(std::uint64_t value, char* out){
+		std::size_t n = 0;
+		for(; value >= 0x80; value >>= 7)
+			out[n++] = (char)(value | 0x80);
+		out[n++] = (char)value;
+		return n;
+	}
+
+	/**
+	 * @brief Decodes up to count values, stopping at a value that is not complete before end
+	 * Runs of 16 single byte values are widened at once and value boundaries are found 16 bytes at a time with SSE2 when available.
+	 * @param in The first byte to decode, advanced past the decoded values
+	 * @param end The end of the encoded bytes
+	 * @param out Room for count values
+	 * @param count The maximum amount of values to decode
+	 * @return std::size_t The amount of values decoded, 0 with at least max_bytes bytes left means the data is corrupt
+	 */
+	static std::size_t decode(const char*& in, const char* end, std::uint64_t* out, const std::size_t count){
+		const unsigned char* p = (const unsigned char*)in;
+		const unsigned char* const last = (const unsigned char*)end;
+		std::size_t n = 0;
+#if defined(__SSE2__) && defined(__GNUC__)
+		while(n < count && last - p >= 16){
+			const unsigned continued = (unsigned)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)p));
+			if(!continued){ // 16 single byte values
+				const std::size_t k = std::min<std::size_t>(16, count - n);
+				for(std::size_t i = 0; i < k; i++)
+					out[n + i] = p[i];
+				n += k, p += k;
+				continue;
+			}
+			unsigned ends = ~continued & 0xFFFF; // the last byte of every value
+			std::size_t start = 0;
+			for(; ends && n < count; ends &= ends - 1){
+				const std::size_t stop = (std::size_t)__builtin_ctz(ends) + 1;
+				if(stop - start > max_bytes)
+					break;
+				out[n++] = _gather(p + start, stop - start);
+				start = stop;
+			}
+			p += start;
+			if(!start) // a value longer than 16 bytes, left to the scalar loop to reject
+				break;
+		}
+#endif
+		for(; n < count; n++){
+			const unsigned char* q = p;
+			while(q < last && q - p < (std::ptrdiff_t)max_bytes && (*q & 0x80))
+				q++;
+			if(q == last || q - p == (std::ptrdiff_t)max_bytes) // incomplete or too long
+				break;
+			out[n] = _gather(p, q - p + 1);
+			p = q + 1;
+		}
+		in = (const char*)p;
+		return n;
+	}
+
+	/**
+	 * @brief Maps a value to the code stored for it, zigzag coding signed values and differences
+	 * @tparam Type The integral type of the value
+	 * @param value The value to map
+	 * @param previous The value before, replaced by value
+	 * @param delta Whether to code the difference to previous
+	 * @return std::uint64_t The code to encode
+	 */
+	template<typename Type>
+	static std::uint64_t pack(const Type value, Type& previous, const bool delta){
+		using Unsigned = typename std::make_unsigned<Type>::type;
+		Unsigned code = delta ? (Unsigned)((Unsigned)value - (Unsigned)previous) : (Unsigned)value;
+		previous = value;
+		if(std::is_signed<Type>::value || delta) // the sign moves to the lowest bit
+			code = (Unsigned)((Unsigned)(code << 1) ^ (Unsigned)-(Unsigned)(code >> (sizeof(Unsigned) * 8 - 1)));
+		return code;
+	}
+
+	/**
+	 * @brief Maps a decoded code back to its value, see pack()
+	 */
+	template<typename Type>
+	static Type unpack(const std::uint64_t decoded, Type& previous, const bool delta){
+		using Unsigned = typename std::make_unsigned<Type>::type;
+		Unsigned code = (Unsigned)decoded;
+		if(std::is_signed<Type>::value || delta)
+			code = (Unsigned)((code >> 1) ^ (Unsigned)-(Unsigned)(code & 1));
+		previous = delta ? (Type)(Unsigned)((Unsigned)previous + code) : (Type)code;
+		return previous;
+	}
+private:
+	static std::uint64_t _gather(const unsigned char* p, const std::size_t length){
+		std::uint64_t value = 0;
+		for(std::size_t i = 0; i < length; i++)
+			value |= (std::uint64_t)(p[i] & 0x7F) << (7 * i);
+		return value;
+	}
+};
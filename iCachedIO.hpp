@@ -0,0 +1,248 @@
+#pragma once
+#include "GRWI.hpp"
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <memory>
+#include <cstdint>
+
+/**
+ * @brief Block cache in front of a seekable interface, for workloads that read the same regions repeatedly
+ * The backend is read in blocks at multiples of the block size, which are kept in a sharded LRU so threads reading
+ * different blocks rarely share a lock. Writes go through to the backend and invalidate the cached blocks they overlap.
+ * Sequential reads use the cache's own read position, sequential writes append at the end of the backend.
+ * All access to the backend must go through the cache while it is in use, or stale blocks must be dropped with invalidate().
+ * Positional reads can run concurrently, like the backend's.
+ */
+class iCachedIO : public iGIO {
+public:
+	/**
+	 * @brief Counters of a cache, summed over all shards
+	 */
+	struct stats {
+		std::uint64_t hits = 0;			// blocks served from the cache
+		std::uint64_t misses = 0;		// blocks read from the backend
+		std::uint64_t evictions = 0;	// blocks dropped to make room
+		std::uint64_t invalidations = 0;// blocks dropped by writes and invalidate()
+	};
+private:
+	struct block {
+		std::uint64_t index;
+		std::size_t length; // bytes of the block that exist in the backend, less than the block size at the end
+		std::unique_ptr<char[]> data;
+	};
+	struct shard {
+		std::mutex mutex;
+		std::list<block> lru; // most recently used first
+		std::unordered_map<std::uint64_t, std::list<block>::iterator> blocks;
+		std::uint64_t generation = 0; // incremented by invalidation, a block read from the backend before is not inserted
+		stats counters;
+	};
+
+	static constexpr std::size_t page_size = 4096;
+
+	iGIO& _backend;
+	const std::size_t _block_size;
+	std::size_t _shard_blocks; // capacity of every shard in blocks
+	std::vector<shard> _shards;
+	std::uint64_t _position = 0; // read position of iRead()
+	std::uint64_t _end; // where sequential writes append
+
+	shard& _shard_of(const std::uint64_t index){
+		return _shards[index % _shards.size()];
+	}
+
+	// copies the bytes of block index from in_block on into buffer, returns the amount copied
+	std::size_t _read_block(const std::uint64_t index, const std::size_t in_block, char* buffer, const std::size_t length){
+		shard& s = _shard_of(index);
+		std::unique_lock<std::mutex> lock(s.mutex);
+		auto found = s.blocks.find(index);
+		if(found != s.blocks.end()){
+			s.lru.splice(s.lru.begin(), s.lru, found->second);
+			s.counters.hits++;
+			return _copy(*found->second, in_block, buffer, length);
+		}
+		s.counters.misses++;
+		const std::uint64_t generation = s.generation;
+		std::unique_ptr<char[]> data;
+		if(s.lru.size() >= _shard_blocks){ // reuse the memory of the least recently used block
+			data = std::move(s.lru.back().data);
+			s.blocks.erase(s.lru.back().index);
+			s.lru.pop_back();
+			s.counters.evictions++;
+		}
+		lock.unlock();
+		if(!data)
+			data = std::make_unique<char[]>(_block_size);
+		block loaded{index, _backend.read_at(index * _block_size, data.get(), _block_size), std::move(data)};
+		const std::size_t n = _copy(loaded, in_block, buffer, length);
+		lock.lock();
+		// not inserted if a write invalidated the shard meanwhile or another thread loaded the block first
+		if(s.generation == generation && s.lru.size() < _shard_blocks && !s.blocks.count(index)){
+			s.lru.push_front(std::move(loaded));
+			s.blocks.emplace(index, s.lru.begin());
+		}
+		return n;
+	}
+
+	static std::size_t _copy(const block& b, const std::size_t in_block, char* buffer, const std::size_t length){
+		if(in_block >= b.length)
+			return 0;
+		const std::size_t n = std::min(length, b.length - in_block);
+		std::memcpy(buffer, b.data.get() + in_block, n);
+		return n;
+	}
+
+	std::size_t _read_cached(const std::uint64_t offset, char* buffer, const std::size_t length){
+		std::size_t n = 0;
+		while(n < length){
+			const std::uint64_t index = (offset + n) / _block_size;
+			const std::size_t in_block = (std::size_t)((offset + n) % _block_size);
+			const std::size_t wanted = std::min(length - n, _block_size - in_block);
+			const std::size_t copied = _read_block(index, in_block, buffer + n, wanted);
+			n += copied;
+			if(copied < wanted) // end of the backend
+				break;
+		}
+		return n;
+	}
+protected:
+	virtual std::size_t iRead(char* buffer, const std::size_t length) override{
+		const std::size_t n = _read_cached(_position, buffer, length);
+		_position += n;
+		return n;
+	}
+
+	virtual std::size_t iWrite(const char* buffer, const std::size_t length) override{
+		const std::size_t n = _backend.write(buffer, length);
+		invalidate(_end, n);
+		_end += n;
+		return n;
+	}
+
+	virtual std::size_t iRead_at(const std::uint64_t offset, char* buffer, const std::size_t length) override{
+		return _read_cached(offset, buffer, length);
+	}
+
+	virtual std::size_t iWrite_at(const std::uint64_t offset, const char* buffer, const std::size_t length) override{
+		const std::size_t n = _backend.write_at(offset, buffer, length);
+		invalidate(offset, length);
+		return n;
+	}
+
+	virtual std::uint64_t iSize() const override{
+		return _backend.size();
+	}
+
+	virtual void iSeek(const std::uint64_t offset) override{
+		_position = offset;
+	}
+
+	virtual void iFlush() override{
+		iGIO::flush(_backend);
+	}
+
+	virtual void iReserve(const std::uint64_t bytes) override{
+		_backend.reserve(bytes);
+	}
+
+	virtual void iAdvise(const access_pattern pattern, const std::uint64_t offset, const std::uint64_t length) override{
+		_backend.advise(pattern, offset, length);
+	}
+
+	// recommended extra method for distuingishing interface
+	virtual inline const char* iName() const {
+		return "CachedIO";
+	}
+public:
+	/**
+	 * @brief Puts a block cache in front of a backend
+	 * @param backend The interface to cache, requires positional access
+	 * @param capacity The maximum amount of cached bytes
+	 * @param block_size The size of a block, rounded up to a multiple of the page size
+	 * @param shards The amount of independently locked LRU lists, blocks are assigned round robin
+	 */
+	iCachedIO(iGIO& backend, const std::size_t capacity = 64 * 1024 * 1024, const std::size_t block_size = page_size, const std::size_t shards = 16)
+		: _backend(backend),
+		  _block_size((std::max<std::size_t>(block_size, 1) + page_size - 1) / page_size * page_size),
+		  _shards(std::max<std::size_t>(shards, 1)),
+		  _end(backend.size()) {
+		_shard_blocks = std::max<std::size_t>(capacity / _block_size / _shards.size(), 1);
+	}
+	iCachedIO(const iCachedIO&) = delete;
+	iCachedIO& operator=(const iCachedIO&) = delete;
+
+	/**
+	 * @brief Drops the cached blocks overlapping a byte range, e.g. after the backend was written to directly
+	 * @param offset The start of the range
+	 * @param length The length of the range
+	 */
+	void invalidate(const std::uint64_t offset, const std::uint64_t length){
+		if(!length)
+			return;
+		const std::uint64_t first = offset / _block_size, last = (offset + length - 1) / _block_size;
+		for(std::size_t i = 0; i < _shards.size() && first + i <= last; i++){ // every shard is locked once
+			shard& s = _shard_of(first + i);
+			std::lock_guard<std::mutex> lock(s.mutex);
+			s.generation++;
+			if((last - first) / _shards.size() > s.blocks.size()){ // fewer cached blocks than blocks in the range
+				for(auto found = s.blocks.begin(); found != s.blocks.end();){
+					if(found->first < first || found->first > last){
+						++found;
+						continue;
+					}
+					s.lru.erase(found->second);
+					found = s.blocks.erase(found);
+					s.counters.invalidations++;
+				}
+				continue;
+			}
+			for(std::uint64_t index = first + i; index <= last; index += _shards.size()){
+				auto found = s.blocks.find(index);
+				if(found == s.blocks.end())
+					continue;
+				s.lru.erase(found->second);
+				s.blocks.erase(found);
+				s.counters.invalidations++;
+			}
+		}
+	}
+
+	/**
+	 * @brief Drops all cached blocks
+	 */
+	void clear(){
+		for(shard& s : _shards){
+			std::lock_guard<std::mutex> lock(s.mutex);
+			s.generation++;
+			s.counters.invalidations += s.lru.size();
+			s.blocks.clear();
+			s.lru.clear();
+		}
+	}
+
+	/**
+	 * @brief The hit, miss, eviction and invalidation counters summed over all shards
+	 * @return stats The counters
+	 */
+	stats statistics(){
+		stats total;
+		for(shard& s : _shards){
+			std::lock_guard<std::mutex> lock(s.mutex);
+			total.hits += s.counters.hits;
+			total.misses += s.counters.misses;
+			total.evictions += s.counters.evictions;
+			total.invalidations += s.counters.invalidations;
+		}
+		return total;
+	}
+
+	/**
+	 * @brief The size of a cached block in bytes
+	 */
+	std::size_t block_size() const {
+		return _block_size;
+	}
+};
@@ -3,60 +3,506 @@
 
 #include <fstream>
 #include <iostream>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <sys/stat.h>
 
 class iFileIO : public iGIO {
+public:
+	/**
+	 * @brief When written data is made durable with fdatasync, see set_durability()
+	 */
+	enum class durability {
+		none,			// left to the kernel's writeback
+		flush,			// every flush() and endl() syncs
+		periodic,		// a background thread syncs unsynced writes every interval
+		group_commit	// flush() and endl() wait for a sync covering their writes, concurrent callers share one sync
+	};
 private:
 	std::string _filename;
-	std::size_t read_offset = 0;
+	int _rfd = -1; // the file offset of the read descriptor is the read position
+	int _wfd = -1; // the file offset of the write descriptor is the end of the file, sequential writes append, iWrite_at() moves it past data it writes after the end
+
+	// direct I/O, see direct_io()
+	int _dfd = -1; // O_DIRECT write descriptor, -1 when sequential writes are buffered by the kernel
+	std::size_t _dalign = 0; // offset, length and memory alignment of direct writes
+	std::unique_ptr<char, decltype(&std::free)> _dbuf{nullptr, &std::free}; // staging buffer, aligned to _dalign
+	std::size_t _dbuf_size = 0;
+	std::size_t _dbuf_used = 0;
+	std::size_t _dbuf_synced = 0; // the first _dbuf_synced staged bytes are already in the file
+	std::uint64_t _dbuf_offset = 0; // file offset of the first staged byte, a multiple of _dalign
+
+	static constexpr std::size_t direct_buffer_bytes = 1024 * 1024;
+
+	std::uint64_t _preallocated = 0; // end of the range preallocated by expect_size() and iReserve(), trimmed to the size on close
+
+	// durability, see set_durability()
+	durability _durability = durability::none;
+	std::atomic<std::uint64_t> _written{0}; // bytes written so far, counted after the write returned
+	std::uint64_t _durable = 0; // _written covered by the last completed sync
+	std::uint64_t _syncs = 0;
+	bool _syncing = false; // a thread is running fdatasync for the group
+	bool _sync_stop = false;
+	std::chrono::milliseconds _sync_interval{100};
+	std::mutex _sync_mutex; // guards the members above from _durable on
+	std::condition_variable _sync_cv;
+	std::thread _sync_thread; // runs _sync_periodic() in periodic mode
+
+	[[noreturn]] void throw_errno(const char* action) const {
+		throw IOfailure(std::string("Error ") + action + ": " + iName() + " file " + std::strerror(errno));
+	}
+
+	void _pwrite_all(const int fd, const char* buffer, const std::size_t length, const std::uint64_t offset){
+		for(std::size_t n = 0; n < length;){
+			ssize_t w = ::pwrite(fd, buffer + n, length - n, (off_t)(offset + n));
+			if(w < 0 && errno == EINTR)
+				continue;
+			if(w < 0)
+				throw_errno("writing");
+			n += w;
+		}
+	}
+
+	// the alignment direct writes need, reported by statx on Linux 6.1 and later, otherwise the page size
+	static std::size_t _direct_alignment(const int fd){
+		std::size_t align = 4096;
+#if defined(__linux__) && defined(STATX_DIOALIGN)
+		struct statx stx;
+		if(::statx(fd, "", AT_EMPTY_PATH, STATX_DIOALIGN, &stx) == 0 && (stx.stx_mask & STATX_DIOALIGN) && stx.stx_dio_offset_align)
+			align = std::max<std::size_t>(stx.stx_dio_offset_align, stx.stx_dio_mem_align);
+#else
+		(void)fd;
+#endif
+		return align;
+	}
+
+	// writes the whole blocks of the staging buffer with O_DIRECT and moves the partial last block to the front
+	void _direct_write_blocks(){
+		const std::size_t blocks = _dbuf_used / _dalign * _dalign;
+		for(std::size_t n = 0; n < blocks;){
+			ssize_t w = ::pwrite(_dfd, _dbuf.get() + n, blocks - n, (off_t)(_dbuf_offset + n));
+			if(w < 0 && errno == EINTR)
+				continue;
+			if(w < 0 && errno == EINVAL && n == 0) // the filesystem accepted O_DIRECT on open but rejects the transfer
+				return _direct_close();
+			if(w < 0)
+				throw_errno("writing");
+			n += w;
+		}
+		std::memmove(_dbuf.get(), _dbuf.get() + blocks, _dbuf_used - blocks);
+		_dbuf_used -= blocks;
+		_dbuf_offset += blocks;
+		_dbuf_synced = _dbuf_synced > blocks ? _dbuf_synced - blocks : 0;
+	}
+
+	// makes all staged bytes visible in the file, the partial last block is written through the page cache and stays staged
+	// only called on the write side, so positional reads and size() never touch the staging buffer
+	void _direct_sync(){
+		if(_dfd < 0 || _dbuf_used == _dbuf_synced)
+			return;
+		_direct_write_blocks();
+		if(_dfd >= 0 && _dbuf_used > _dbuf_synced){
+			_pwrite_all(_wfd, _dbuf.get() + _dbuf_synced, _dbuf_used - _dbuf_synced, _dbuf_offset + _dbuf_synced);
+			_dbuf_synced = _dbuf_used;
+		}
+	}
+
+	// finalizes the staged bytes and returns to buffered sequential writes
+	void _direct_close(){
+		if(_dfd < 0)
+			return;
+		const int fd = _dfd;
+		_dfd = -1;
+		::close(fd);
+		_pwrite_all(_wfd, _dbuf.get() + _dbuf_synced, _dbuf_used - _dbuf_synced, _dbuf_offset + _dbuf_synced);
+		if(::lseek(_wfd, (off_t)(_dbuf_offset + _dbuf_used), SEEK_SET) < 0)
+			throw_errno("seeking");
+		_dbuf.reset();
+		_dbuf_size = _dbuf_used = _dbuf_synced = 0;
+	}
+
+	// syncs everything written so far unless a sync covering target already finished, lock must hold _sync_mutex
+	// force always runs a sync of its own, after a running one finished
+	void _sync_locked(std::unique_lock<std::mutex>& lock, const std::uint64_t target, bool force = false){
+		while(force || _durable < target){
+			if(_syncing){ // wait for the running sync, if it does not cover target one of the waiters starts the next
+				_sync_cv.wait(lock);
+				continue;
+			}
+			_syncing = true;
+			const std::uint64_t covered = _written.load();
+			lock.unlock();
+			const int result = ::fdatasync(_wfd);
+			const int error = errno;
+			lock.lock();
+			_syncing = false;
+			_sync_cv.notify_all();
+			if(result < 0){
+				errno = error;
+				throw_errno("syncing");
+			}
+			_durable = std::max(_durable, covered);
+			_syncs++;
+			force = false;
+		}
+	}
+
+	void _sync_periodic(){
+		std::unique_lock<std::mutex> lock(_sync_mutex);
+		while(!_sync_stop){
+			_sync_cv.wait_for(lock, _sync_interval, [this]{ return _sync_stop; });
+			try{
+				_sync_locked(lock, _written.load());
+			} catch(const IOfailure&){} // retried on the next interval, flush() reports errors in the other modes
+		}
+	}
+
+	void _stop_periodic(){
+		if(!_sync_thread.joinable())
+			return;
+		{
+			std::lock_guard<std::mutex> lock(_sync_mutex);
+			_sync_stop = true;
+		}
+		_sync_cv.notify_all();
+		_sync_thread.join();
+		_sync_stop = false;
+	}
+
+	// preallocates [offset, end) without changing the size of the file, returns false if the filesystem does not support it
+	bool _preallocate(const std::uint64_t offset, const std::uint64_t end){
+		if(end <= _preallocated)
+			return true;
+#ifdef __linux__
+		if(::fallocate(_wfd, FALLOC_FL_KEEP_SIZE, (off_t)offset, (off_t)(end - offset)) == 0){
+			_preallocated = end;
+			return true;
+		}
+#else
+		(void)offset;
+#endif
+		return false; // only a hint, a write that does not fit fails on its own
+	}
+
+	// releases the preallocated blocks after the end of the file
+	void _trim(){
+		struct stat st;
+		if(_preallocated && ::fstat(_wfd, &st) == 0 && (std::uint64_t)st.st_size < _preallocated)
+			(void)::ftruncate(_wfd, st.st_size);
+		_preallocated = 0;
+	}
+
+	std::size_t _direct_write(const char* buffer, const std::size_t length){
+		for(std::size_t n = 0; n < length;){
+			if(_dfd < 0){ // fell back to buffered writes
+				_written += n;
+				return n + iWrite(buffer + n, length - n);
+			}
+			const std::size_t k = std::min(length - n, _dbuf_size - _dbuf_used);
+			std::memcpy(_dbuf.get() + _dbuf_used, buffer + n, k);
+			_dbuf_used += k;
+			n += k;
+			if(_dbuf_used == _dbuf_size)
+				_direct_write_blocks();
+		}
+		_written += length;
+		return length;
+	}
 protected:
 	virtual std::size_t iRead(char* buffer, const std::size_t length) override{
-		std::ifstream file(_filename, std::ios_base::in);
-		file.seekg(read_offset, std::ios_base::beg);
-		file.read(buffer, length);
-		int n = file.gcount(); // check read success
-		read_offset += n;
-		if(file.eof())
-			buffer[0] = '\0', n = 0;
-		else if(file.bad() || file.fail()){
-			file.close();
-			throw IOfailure(std::string("Error reading: ") + iName() + " file " + (file.bad() ? "bad" : "fail"));
-		}
-		file.close();
+		std::size_t n = 0;
+		while(n < length){ // regular files only return short reads at the end of the file
+			ssize_t r = ::read(_rfd, buffer + n, length - n);
+			if(r < 0 && errno == EINTR)
+				continue;
+			if(r < 0)
+				throw_errno("reading");
+			if(r == 0)
+				break;
+			n += r;
+		}
 		return n;
 	}
 
 	virtual std::size_t iWrite(const char* buffer, const std::size_t length) override{
-		std::ofstream file(_filename, std::ios_base::out | std::ios_base::app);
-		file.write(buffer, length);
-		int n = length;
-		if(file.fail() || file.bad()){ // check write success
-			file.close();
-			throw IOfailure(std::string("Error reading: ") + iName() + " file " + (file.bad() ? "bad" : "fail"));
-		}
-		file.close();
+		if(_dfd >= 0)
+			return _direct_write(buffer, length);
+		std::size_t n = 0;
+		while(n < length){
+			ssize_t w = ::write(_wfd, buffer + n, length - n);
+			if(w < 0 && errno == EINTR)
+				continue;
+			if(w < 0)
+				throw_errno("writing");
+			n += w;
+		}
+		_written += n;
+		return n;
+	}
+
+	virtual std::size_t iWrite_gather(const IOSegment* segments, const std::size_t count) override{
+		std::size_t n = 0;
+		if(_dfd >= 0){
+			for(std::size_t i = 0; i < count; i++)
+				n += _direct_write(segments[i].data, segments[i].length);
+			return n;
+		}
+		struct iovec iov[64];
+		for(std::size_t i = 0; i < count;){
+			// fill a batch of iovecs, writev accepts at most IOV_MAX per call
+			std::size_t batch = 0, batch_bytes = 0;
+			for(; batch < 64 && i + batch < count; batch++){
+				iov[batch].iov_base = (void*)segments[i + batch].data;
+				iov[batch].iov_len  = segments[i + batch].length;
+				batch_bytes += segments[i + batch].length;
+			}
+			ssize_t w = ::writev(_wfd, iov, batch);
+			if(w < 0 && errno == EINTR)
+				continue;
+			if(w < 0)
+				throw_errno("writing");
+			n += w;
+			_written += w;
+			if((std::size_t)w < batch_bytes){ // finish a short write segment by segment
+				std::size_t done = w;
+				for(std::size_t j = 0; j < batch; j++){
+					if(done >= segments[i + j].length){
+						done -= segments[i + j].length;
+						continue;
+					}
+					n += iWrite(segments[i + j].data + done, segments[i + j].length - done);
+					done = 0;
+				}
+			}
+			i += batch;
+		}
 		return n;
 	}
 
+	virtual std::size_t iRead_at(const std::uint64_t offset, char* buffer, const std::size_t length) override{
+		for(;;){ // pread does not use the descriptor's offset, so concurrent calls need no locking
+			ssize_t r = ::pread(_rfd, buffer, length, (off_t)offset);
+			if(r < 0 && errno == EINTR)
+				continue;
+			if(r < 0)
+				throw_errno("reading");
+			return r;
+		}
+	}
+
+	virtual std::size_t iWrite_at(const std::uint64_t offset, const char* buffer, const std::size_t length) override{
+		_direct_sync();
+		_pwrite_all(_wfd, buffer, length, offset);
+		_written += length;
+		if(_dfd >= 0 && offset < _dbuf_offset + _dbuf_used && offset + length > _dbuf_offset){ // keep the staged block up to date
+			const std::uint64_t first = std::max<std::uint64_t>(offset, _dbuf_offset), last = std::min<std::uint64_t>(offset + length, _dbuf_offset + _dbuf_used);
+			std::memcpy(_dbuf.get() + (first - _dbuf_offset), buffer + (first - offset), last - first);
+		}
+		// pwrite leaves the descriptor's offset alone, move the append position to the new end
+		if(_dfd >= 0 && offset + length > _dbuf_offset + _dbuf_used){
+			_direct_close();
+			if(::lseek(_wfd, 0, SEEK_END) < 0)
+				throw_errno("seeking");
+			direct_io(); // stages the partial block before the new end
+		}
+		else if(_dfd < 0 && ::lseek(_wfd, 0, SEEK_END) < 0)
+			throw_errno("seeking");
+		return length;
+	}
+
+	virtual std::uint64_t iSize() const override{
+		struct stat st;
+		if(::fstat(_wfd, &st) < 0)
+			throw_errno("reading size");
+		if(_dfd >= 0) // staged bytes count before they reach the file
+			return std::max<std::uint64_t>(st.st_size, _dbuf_offset + _dbuf_used);
+		return st.st_size;
+	}
+
+	virtual void iSeek(const std::uint64_t offset) override{
+		if(::lseek(_rfd, (off_t)offset, SEEK_SET) < 0)
+			throw_errno("seeking");
+	}
+
+	virtual void iReserve(const std::uint64_t bytes) override{
+		const off_t position = _dfd >= 0 ? (off_t)(_dbuf_offset + _dbuf_used) : ::lseek(_wfd, 0, SEEK_CUR);
+		if(position >= 0)
+			_preallocate(position, position + bytes);
+	}
+
+	virtual void iAdvise(const access_pattern pattern, const std::uint64_t offset, const std::uint64_t length) override{
+#ifdef POSIX_FADV_NORMAL
+		// readahead settings belong to the open file, so they are set on the read descriptor
+		static const int advice[] = {POSIX_FADV_NORMAL, POSIX_FADV_SEQUENTIAL, POSIX_FADV_RANDOM, POSIX_FADV_DONTNEED};
+		(void)::posix_fadvise(_rfd, (off_t)offset, (off_t)length, advice[(int)pattern]);
+#else
+		(void)pattern, (void)offset, (void)length;
+#endif
+	}
+
+	virtual void iFlush() override{
+		_direct_sync();
+		if(_durability == durability::flush || _durability == durability::group_commit){
+			std::unique_lock<std::mutex> lock(_sync_mutex);
+			_sync_locked(lock, _written.load(), _durability == durability::flush);
+		}
+	}
+
+	virtual int iReadFd() const override{
+		return _rfd;
+	}
+
+	virtual int iWriteFd() const override{
+		if(_durability == durability::periodic || _durability == durability::group_commit) // kernel copies would not be counted in _written
+			return -1;
+		return _dfd < 0 ? _wfd : -1; // staged bytes must not be bypassed
+	}
+
 	// recommended extra method for distuingishing interface
 	virtual inline const char* iName() const {
 		return "FileIO";
 	}
 public:
-	iFileIO(std::string filename) 
+	/**
+	 * @brief Opens a file for reading and writing, creating it if it does not exist
+	 * @param filename The path of the file
+	 * @param truncate Whether existing contents are discarded, otherwise reading starts at the beginning and writing appends
+	 */
+	iFileIO(std::string filename, const bool truncate = true)
 		: _filename(filename) {
-		std::ofstream file(_filename, std::ios_base::out);
-		if(!file.is_open())
+		_wfd = ::open(_filename.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : 0), 0644);
+		if(_wfd < 0)
+			throw std::runtime_error("failed to open file " + filename);
+		if(!truncate && ::lseek(_wfd, 0, SEEK_END) < 0){
+			::close(_wfd);
 			throw std::runtime_error("failed to open file " + filename);
-		cleanFile();
+		}
+		_rfd = ::open(_filename.c_str(), O_RDONLY | O_CLOEXEC);
+		if(_rfd < 0){
+			::close(_wfd);
+			throw std::runtime_error("failed to open file " + filename);
+		}
+	}
+	iFileIO(const iFileIO&) = delete;
+	iFileIO& operator=(const iFileIO&) = delete;
+	virtual ~iFileIO(){
+		_stop_periodic();
+		try{
+			_direct_close();
+			_trim();
+			if(_durability != durability::none)
+				::fdatasync(_wfd);
+		} catch(...){}
+		::close(_rfd);
+		::close(_wfd);
+	}
+
+	/**
+	 * @brief Switches sequential writes to O_DIRECT, bypassing the page cache for large streaming writes
+	 * Writes are staged in a buffer aligned to the filesystem's direct I/O alignment and written in whole blocks.
+	 * The unaligned tail is written through the page cache on flush(), write_at(), close, or when direct I/O is disabled,
+	 * reads only see staged bytes after one of those.
+	 * Filesystems without O_DIRECT support, e.g. tmpfs, keep buffered writes.
+	 * @param enable Whether to use direct I/O, disabling writes all staged bytes
+	 * @return bool Whether direct I/O is in use
+	 */
+	bool direct_io(const bool enable = true){
+		if(!enable || _dfd >= 0){
+			if(!enable)
+				_direct_close();
+			return _dfd >= 0;
+		}
+#ifdef O_DIRECT
+		const int fd = ::open(_filename.c_str(), O_WRONLY | O_DIRECT | O_CLOEXEC);
+		if(fd < 0)
+			return false;
+		const off_t end = ::lseek(_wfd, 0, SEEK_CUR);
+		if(end < 0){
+			::close(fd);
+			throw_errno("seeking");
+		}
+		_dalign = _direct_alignment(fd);
+		_dbuf_size = (std::max(ChunkBytes, direct_buffer_bytes) + _dalign - 1) / _dalign * _dalign;
+		_dbuf.reset((char*)std::aligned_alloc(_dalign, _dbuf_size));
+		if(!_dbuf){
+			::close(fd);
+			throw std::bad_alloc();
+		}
+		// stage the bytes of the partial block before the write position, direct writes start at an aligned offset
+		_dbuf_offset = end / _dalign * _dalign;
+		_dbuf_used = _dbuf_synced = end - _dbuf_offset;
+		for(std::size_t n = 0; n < _dbuf_used;){
+			ssize_t r = ::pread(_rfd, _dbuf.get() + n, _dbuf_used - n, (off_t)(_dbuf_offset + n));
+			if(r < 0 && errno == EINTR)
+				continue;
+			if(r <= 0){
+				::close(fd);
+				_dbuf.reset();
+				throw_errno("reading");
+			}
+			n += r;
+		}
+		_dfd = fd;
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	/**
+	 * @brief Selects when written data is made durable with fdatasync, see durability
+	 * In group commit mode threads writing and flushing concurrently share syncs, each flush() returns once a sync
+	 * started after its writes completed. Sequential writes from several threads must not use direct_io().
+	 * The destructor syncs unsynced writes in every mode except none. Throws IOfailure from flush() when fdatasync fails.
+	 * In periodic and group commit mode transfer() into the file copies through user space so its writes are counted.
+	 * @param policy The durability mode
+	 * @param interval The time between syncs in periodic mode
+	 */
+	void set_durability(const durability policy, const std::chrono::milliseconds interval = std::chrono::milliseconds(100)){
+		_stop_periodic();
+		_durability = policy;
+		_sync_interval = interval;
+		if(policy == durability::periodic)
+			_sync_thread = std::thread([this]{ _sync_periodic(); });
+	}
+
+	/**
+	 * @brief The amount of fdatasync calls made by the durability policy, e.g. to measure group commit batching
+	 */
+	std::uint64_t syncs(){
+		std::lock_guard<std::mutex> lock(_sync_mutex);
+		return _syncs;
+	}
+
+	/**
+	 * @brief Preallocates the file for an expected final size, which keeps large sequential writes contiguous on disk
+	 * The size of the file is not changed, the unused part is released when the file is closed.
+	 * Bulk writes preallocate their own size through reserve().
+	 * @param bytes The expected final size of the file
+	 * @return bool Whether the filesystem preallocated, false if it does not support fallocate
+	 */
+	bool expect_size(const std::uint64_t bytes){
+		return _preallocate(0, bytes);
 	}
-	virtual ~iFileIO(){}
 
 	void cleanFile() {
-		read_offset = 0;
-		std::ofstream file(_filename, std::ios_base::out);
-		if(!file.is_open())
-			throw std::runtime_error("failed to open file " + _filename);
-		file << "" << std::flush;
-		file.close();
-	}
-};
\ No newline at end of file
+		discard_read_ahead();
+		if(_dfd >= 0){ // drop the staged bytes
+			_dbuf_offset = _dbuf_used = _dbuf_synced = 0;
+		}
+		if(::ftruncate(_wfd, 0) < 0 || ::lseek(_wfd, 0, SEEK_SET) < 0 || ::lseek(_rfd, 0, SEEK_SET) < 0)
+			throw std::runtime_error("failed to clean file " + _filename);
+		_preallocated = 0; // truncating released the preallocated blocks
+	}
+};
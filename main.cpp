@@ -68,22 +68,23 @@ int main(){
 
 	std::cout << "finished string to r/w" << std::endl;
 
-	// TODO: this
-	// std::vector<int> buffer;
+	std::vector<int> buffer;
 	int v[][2] = {{5}, {6}, {7}, {8}};
-	// file.write(v); // TODO
+	file.write(v);
 	int v2[4] = {};
 	file.write(v2);
-	// file.read<std::string>(buffer, "\n", [](std::string text){
-	// 	return std::stoi(text);
-	// });
-	// std::cout << "buffer: ";
-	// for(int i : buffer)
-	// 	std::cout << i << " ";
-	// std::cout << std::endl;
-
-	// std::cout << "finished array based predicate reading to r/w" << std::endl;
-	// file.cleanFile();
+	file.cleanFile();
+
+	file << iGIO::text << 5 << " " << 6 << std::endl << iGIO::binary;
+	file.write_text(vec, ",");
+	file.read_text(buffer, ",");
+	std::cout << "buffer: ";
+	for(int i : buffer)
+		std::cout << i << " ";
+	std::cout << std::endl;
+
+	std::cout << "finished text based reading to r/w" << std::endl;
+	file.cleanFile();
 	
 	std::stringstream temp;
 	// std::ofstream os("temp.txt");
@@ -122,12 +123,12 @@ int main(){
 	// DONE: string reading
 	//? DONE?: container reading
 	//? DONE?: operator << and >> overloading
-	// TODO: N-Dimensional arrays
+	// DONE: N-Dimensional arrays
 	// TODO: initializer lists 
 
 	// TODO: terminator arrays? 
-	// TODO: delimiters? e.g. read string splitting? also implement for writing?
-	// TODO: input parsers???
+	// DONE: delimiters? e.g. read string splitting? also implement for writing?
+	// DONE: input parsers??? (read_text)
 
 	return 0;
 }
\ No newline at end of file
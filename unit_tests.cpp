@@ -1,8 +1,22 @@
 #include "iFileIO.hpp"
+#include "gio_streambuf.hpp"
+#include "gio_transfer.hpp"
+#include "gio_record_log.hpp"
+#include "gio_line_index.hpp"
+#include "gio_parallel_reader.hpp"
+#include "iCachedIO.hpp"
+#include "gio_lz_filter.hpp"
+#include "gio_crc32c_filter.hpp"
+#include "gio_chacha20_filter.hpp"
 #include <iostream>
 #include <iomanip>
 
 #include <array>
+#include <iterator>
+#include <string_view>
+#if __has_include(<span>)
+#include <span>
+#endif
 #include <vector>
 #include <deque>
 #include <forward_list>
@@ -19,6 +33,9 @@
 #include <istream>
 #include <fstream>
 #include <sstream>
+#include <thread>
+#include <chrono>
+#include <cstdio>
 
 #include <codecvt>
 #include <locale>
@@ -46,6 +63,12 @@ using can_write = can_apply<write_r, F, Ts...>;
 template<class F, class...Ts>
 using can_read = can_apply<read_r, F, Ts...>;
 
+template<class F, class...Ts>
+using write_varint_r = decltype(std::declval<F>().write_varint( std::declval<Ts>()... ));
+
+template<class F, class...Ts>
+using can_write_varint = can_apply<write_varint_r, F, Ts...>;
+
 struct test_struct {
 	int a = 0;
 	int b = 0;
@@ -105,6 +128,28 @@ public:
 	}
 };
 
+// in memory interface without file descriptors, for the generic code paths
+class test_memoryIO : public iGIO {
+	std::string _data;
+	std::size_t _read_pos = 0;
+protected:
+	std::size_t iRead(char* buffer, const std::size_t length) override{
+		std::size_t n = std::min(length, _data.size() - _read_pos);
+		std::memcpy(buffer, _data.data() + _read_pos, n);
+		_read_pos += n;
+		return n;
+	}
+
+	std::size_t iWrite(const char* buffer, const std::size_t length) override{
+		_data.append(buffer, length);
+		return length;
+	}
+public:
+	const std::string& data() const {
+		return _data;
+	}
+};
+
 iFileIO file("test.txt");
 
 #define w(_w) std::setw(_w)
@@ -652,6 +697,40 @@ void Container_test(){
 	}
 }
 
+void NDimensional_test(){
+	std::cout << "\n[N-dimensional test]" << std::endl;
+	{
+	int test[4][2] = {{10, 11}, {12, 13}, {14, 15}, {16, 17}};
+	int ret_test[4][2] = {};
+	file.write(test);
+	file.read(ret_test);
+	std::string equal = std::equal(&test[0][0], &test[0][0] + 8, &ret_test[0][0]) ? "[success] : " : "[failure] : ";
+	std::cout << equal << "array int[4][2]: ";
+	print_arr(&ret_test[0][0], 8);
+	file.cleanFile();
+	}
+	{
+	std::array<std::array<int, 2>, 3> test = {{{10, 11}, {12, 13}, {14, 15}}};
+	int ret_test[3][2] = {};
+	file.write(test);
+	file.read(ret_test);
+	std::string equal = std::equal(&test[0][0], &test[0][0] + 6, &ret_test[0][0]) ? "[success] : " : "[failure] : ";
+	std::cout << equal << "array<array<int, 2>, 3>: ";
+	print_arr(&ret_test[0][0], 6);
+	file.cleanFile();
+	}
+	{
+	std::vector<std::vector<int>> test = {{10, 11, 12}, {}, {13}, {14, 15}};
+	std::vector<int> ret_test;
+	file.write(test);
+	file.read(ret_test);
+	std::string equal = std::vector<int>{10, 11, 12, 13, 14, 15} == ret_test ? "[success] : " : "[failure] : ";
+	std::cout << equal << "vector<vector<int>>: ";
+	print_container(ret_test.begin(), ret_test.end());
+	file.cleanFile();
+	}
+}
+
 void String_test(){
 	std::cout << "\n[String test]" << std::endl;
 	{
@@ -698,6 +777,44 @@ void String_test(){
 	}
 }
 
+void View_test(){
+	std::cout << "\n[View test]" << std::endl;
+	{
+	std::string_view test = "string_view!";
+	std::string ret_test;
+	
+	file.write(test);
+	file.read(ret_test);
+	std::string equal = test == ret_test ? "[success] : " : "[failure] : ";
+	std::cout << equal << "string_view: " << ret_test << std::endl;
+	file.cleanFile();
+	}
+	{
+	std::array<int, 4> test = {10, 11, 12, 13};
+	std::array<int, 4> ret_test = {};
+	
+	file.write(test);
+	file.read(ret_test);
+	std::string equal = test == ret_test ? "[success] : " : "[failure] : ";
+	std::cout << equal << "array<int, 4>: ";
+	print_container(ret_test.begin(), ret_test.end());
+	file.cleanFile();
+	}
+#ifdef __cpp_lib_span
+	{
+	int test[4] = {10, 11, 12, 13};
+	std::vector<int> ret_test(4, 0);
+	
+	file.write(std::span<const int>(test));
+	file.read(std::span<int>(ret_test));
+	std::string equal = std::equal(std::begin(test), std::end(test), ret_test.begin()) ? "[success] : " : "[failure] : ";
+	std::cout << equal << "span<int>: ";
+	print_container(ret_test.begin(), ret_test.end());
+	file.cleanFile();
+	}
+#endif
+}
+
 void Stream_test(){
 	std::cout << "\n[Stream test]" << std::endl;
 	{
@@ -713,6 +830,1438 @@ void Stream_test(){
 		std::cout << equal << "stringstream: " << in.str() << std::endl;
 		file.cleanFile();
 	}
+	{
+		std::stringstream out;
+		std::string ret_test;
+		for(int i = 0; i < 20000; i++) // spans multiple chunks
+			out << "line " << i << "\n";
+
+		file.write(out);
+		file.read(ret_test);
+		std::string equal = out.str() == ret_test ? "[success] : " : "[failure] : ";
+		std::cout << equal << "stringstream bulk: " << ret_test.size() << " characters" << std::endl;
+		file.cleanFile();
+	}
+	{
+		std::stringstream out;
+		std::string ret_test;
+		out << "hello world!\nsecond  line";
+
+		file.write(out, ",");
+		file.read(ret_test);
+		std::string equal = "hello,world!,second,line" == ret_test ? "[success] : " : "[failure] : ";
+		std::cout << equal << "stringstream tokenized: " << ret_test << std::endl;
+		file.cleanFile();
+	}
+}
+
+void Streambuf_test(){
+	std::cout << "\n[Streambuf test]" << std::endl;
+	{
+		std::string ret_test;
+		{
+			gio_streambuf buf(file, 16);
+			std::ostream os(&buf);
+			os << "value " << 42 << ' ' << 1.5 << " and a string longer than the buffer" << std::flush;
+		}
+		file.read(ret_test);
+		std::string equal = "value 42 1.5 and a string longer than the buffer" == ret_test ? "[success] : " : "[failure] : ";
+		std::cout << equal << "ostream: " << ret_test << std::endl;
+		file.cleanFile();
+	}
+	{
+		int a = 0, b = 0;
+		std::string line;
+		int ret_test = 0;
+		file.write("12 34\nabc\n");
+		file.write(56);
+		{
+			gio_streambuf buf(file);
+			std::istream is(&buf);
+			is >> a >> b;
+			is.ignore(1);
+			std::getline(is, line);
+		} // unread input is returned to the interface
+		file.read(ret_test);
+		std::string equal = a == 12 && b == 34 && line == "abc" && ret_test == 56 ? "[success] : " : "[failure] : ";
+		std::cout << equal << "istream: " << a << " " << b << " " << line << " " << ret_test << std::endl;
+		file.cleanFile();
+	}
+	{
+		std::stringstream in;
+		std::stringstream out;
+		for(int i = 0; i < 20000; i++)
+			in << "line " << i << "\n";
+		{
+			gio_streambuf buf(file);
+			std::ostream os(&buf);
+			os << in.rdbuf();
+		}
+		out << file;
+		std::string equal = in.str() == out.str() ? "[success] : " : "[failure] : ";
+		std::cout << equal << "rdbuf copy: " << out.str().size() << " characters" << std::endl;
+		file.cleanFile();
+	}
+}
+
+void Record_test(){
+	std::cout << "\n[Record test]" << std::endl;
+	{
+	std::vector<std::string> test = {"first", "second", "", "third"};
+	std::vector<std::string> ret_test;
+	
+	file.write("first\nsecond\n\nthird");
+	for(std::string_view line : file.lines())
+		ret_test.emplace_back(line);
+	std::string equal = test == ret_test ? "[success] : " : "[failure] : ";
+	std::cout << equal << "lines: ";
+	print_container(ret_test.begin(), ret_test.end());
+	file.cleanFile();
+	}
+	{
+	std::vector<std::string> test;
+	std::vector<std::string> ret_test;
+	for(int i = 0; i < 20000; i++){ // spans multiple read-ahead buffer refills
+		test.push_back("record" + std::to_string(i));
+		file.write(test.back());
+		file.write("\r\n");
+	}
+	
+	for(std::string_view record : file.records("\r\n"))
+		ret_test.emplace_back(record);
+	std::string equal = test == ret_test ? "[success] : " : "[failure] : ";
+	std::cout << equal << "records(\"\\r\\n\"): " << ret_test.size() << " records" << std::endl;
+	file.cleanFile();
+	}
+	{
+	int ret_test = 0;
+	
+	file.write("header\n");
+	file.write(13);
+	auto lines = file.lines();
+	auto line = lines.begin();
+	file.read(ret_test); // continues from the read-ahead buffer
+	std::string equal = *line == "header" && ret_test == 13 ? "[success] : " : "[failure] : ";
+	std::cout << equal << "lines then int: " << *line << ", " << ret_test << std::endl;
+	file.cleanFile();
+	}
+}
+
+void Text_test(){
+	std::cout << "\n[Text test]" << std::endl;
+	{
+	int test[4] = {10, -11, 12, 13};
+	int ret_test[4] = {0, 0, 0, 0};
+	
+	file.write("10 -11\t12\n+13\n");
+	for(int& i : ret_test)
+		file.read_text(i);
+	std::string equal = std::equal(std::begin(test), std::end(test), std::begin(ret_test)) ? "[success] : " : "[failure] : ";
+	std::cout << equal << "text int: ";
+	print_arr(ret_test, 4);
+	file.cleanFile();
+	}
+	{
+	std::vector<double> test = {1.5, 2.25, 300, -4};
+	std::vector<double> ret_test;
+	
+	file.write("1.5,2.25,,3e2\n-4");
+	file.read_text(ret_test, ",");
+	std::string equal = test == ret_test ? "[success] : " : "[failure] : ";
+	std::cout << equal << "text vector<double>: ";
+	print_container(ret_test.begin(), ret_test.end());
+	file.cleanFile();
+	}
+	{
+	std::string ret_test;
+	
+	file << iGIO::text << 42 << " " << -2.5 << std::endl << iGIO::binary;
+	file.read(ret_test);
+	std::string equal = "42 -2.5\n" == ret_test ? "[success] : " : "[failure] : ";
+	std::cout << equal << "text operator<<: " << ret_test;
+	file.cleanFile();
+	}
+	{
+	std::vector<int> test = {3, -1, 40000}, ret_test;
+	
+	file << iGIO::text << test;
+	file >> ret_test;
+	file << iGIO::binary;
+	std::string equal = test == ret_test ? "[success] : " : "[failure] : ";
+	std::cout << equal << "text operator<< and operator>> vector<int>: ";
+	print_container(ret_test.begin(), ret_test.end());
+	file.cleanFile();
+	}
+	{
+	std::vector<double> test = {0.1, -1e300, 3, 2.5e-8};
+	std::vector<double> ret_test;
+	
+	file.write_text(test, ",");
+	file.read_text(ret_test, ",");
+	std::string equal = test == ret_test ? "[success] : " : "[failure] : ";
+	std::cout << equal << "text vector<double> round trip: ";
+	print_container(ret_test.begin(), ret_test.end());
+	file.cleanFile();
+	}
+	{
+	int ret_test = 0;
+	bool thrown = false;
+	
+	file.write("12a");
+	try{
+		file.read_text(ret_test);
+	} catch(const iGIO::IOfailure& e){
+		thrown = true;
+	}
+	std::string equal = thrown ? "[success] : " : "[failure] : ";
+	std::cout << equal << "text invalid number throws" << std::endl;
+	file.cleanFile();
+	}
+	{
+	int ret_test = 0;
+	bool thrown = false;
+	
+	file.write("+-5");
+	try{
+		file.read_text(ret_test);
+	} catch(const iGIO::IOfailure& e){
+		thrown = true;
+	}
+	std::string equal = thrown ? "[success] : " : "[failure] : ";
+	std::cout << equal << "text sign after plus throws" << std::endl;
+	file.cleanFile();
+	}
+}
+
+void Transfer_test(){
+	std::cout << "\n[Transfer test]" << std::endl;
+	std::string test;
+	for(int i = 0; i < 50000; i++) // spans multiple chunks
+		test += "line" + std::to_string(i) + "\n";
+	{
+	iFileIO src("transfer_src.txt"), dst("transfer_dst.txt");
+	std::string ret_test;
+	
+	src.write(test);
+	std::size_t n = transfer(src, dst);
+	dst.read(ret_test, test.size());
+	std::string equal = n == test.size() && test == ret_test ? "[success] : " : "[failure] : ";
+	std::cout << equal << "file to file: " << n << " bytes" << std::endl;
+	}
+	{
+	iFileIO src("transfer_src.txt"), dst("transfer_dst.txt");
+	std::string ret_test;
+	
+	src.write(test);
+	auto lines = src.lines();
+	std::string_view first = *lines.begin(); // leaves data in the read-ahead buffer
+	std::size_t n = transfer(src, dst, 100);
+	dst.read(ret_test, 100);
+	std::string equal = first == "line0" && n == 100 && test.substr(6, 100) == ret_test ? "[success] : " : "[failure] : ";
+	std::cout << equal << "file to file after lines(), 100 bytes: " << n << " bytes" << std::endl;
+	}
+	{
+	test_memoryIO src, dst;
+	iFileIO middle("transfer_src.txt");
+	
+	src.write(test);
+	std::size_t to_file = transfer(src, middle);
+	std::size_t to_memory = transfer(middle, dst);
+	std::string equal = to_file == test.size() && to_memory == test.size() && test == dst.data() ? "[success] : " : "[failure] : ";
+	std::cout << equal << "memory to file to memory: " << to_memory << " bytes" << std::endl;
+	}
+	{
+	iFileIO same("transfer_src.txt");
+	std::string ret_test;
+	
+	same.write(std::string("abc"));
+	std::size_t n = transfer(same, same);
+	iFileIO check("transfer_src.txt", false);
+	check.read(ret_test, 6);
+	std::string equal = n == 3 && ret_test == "abcabc" ? "[success] : " : "[failure] : ";
+	std::cout << equal << "file to itself: " << n << " bytes" << std::endl;
+	}
+	{
+	iFileIO src("transfer_src.txt");
+	std::string ret_test;
+	
+	src.write(test);
+	iFileIO dst("transfer_src.txt", false); // appends after the data written above
+	std::size_t n = transfer(src, dst);
+	iFileIO check("transfer_src.txt", false);
+	check.read(ret_test, 2 * test.size());
+	std::string equal = n == test.size() && ret_test == test + test ? "[success] : " : "[failure] : ";
+	std::cout << equal << "file to the same file: " << n << " bytes" << std::endl;
+	}
+	std::remove("transfer_src.txt");
+	std::remove("transfer_dst.txt");
+}
+
+void Positional_test(){
+	std::cout << "\n[Positional test]" << std::endl;
+	{
+	std::vector<int> test(100000);
+	for(std::size_t i = 0; i < test.size(); i++)
+		test[i] = (int)i;
+	std::vector<int> ret_test(test.size());
+	
+	file.write(test);
+	std::vector<std::thread> readers;
+	for(std::size_t t = 0; t < 4; t++) // disjoint regions, read concurrently
+		readers.emplace_back([&, t]{
+			std::size_t part = test.size() / 4;
+			file.read_at(t * part * sizeof(int), &ret_test[t * part], part);
+		});
+	for(auto& reader : readers)
+		reader.join();
+	std::string equal = test == ret_test && file.size() == test.size() * sizeof(int) ? "[success] : " : "[failure] : ";
+	std::cout << equal << "read_at from 4 threads: " << file.size() << " bytes" << std::endl;
+	file.cleanFile();
+	}
+	{
+	int ret_int = 0;
+	std::string ret_test;
+	
+	file.write("0123456789");
+	file.write_at(2, std::string("ab"));
+	file.write_at(10, 7);
+	file.read_at(1, ret_test, 4);
+	file.read_at(10, ret_int);
+	std::string sequential;
+	file.read(sequential, 10); // the read position is not moved by positional calls
+	std::string equal = ret_test == "1ab4" && ret_int == 7 && sequential == "01ab456789" ? "[success] : " : "[failure] : ";
+	std::cout << equal << "write_at, read_at: " << ret_test << ", " << ret_int << ", " << sequential << std::endl;
+	file.cleanFile();
+	}
+	{
+	std::vector<int> ret_test(3);
+	
+	file.write(1);
+	file.write_at(sizeof(int), 2); // past the end of the file
+	file.write(3); // sequential writes still append
+	file.read(ret_test.data(), ret_test.size());
+	std::string equal = ret_test == std::vector<int>{1, 2, 3} && file.size() == 3 * sizeof(int) ? "[success] : " : "[failure] : ";
+	std::cout << equal << "write after write_at past the end appends: ";
+	print_container(ret_test.begin(), ret_test.end());
+	file.cleanFile();
+	}
+	{
+	test_memoryIO memory;
+	int ret_test = 0;
+	bool thrown = false;
+	try{ memory.read_at(0, ret_test); } catch(iGIO::IOfailure&){ thrown = true; }
+	std::string equal = thrown ? "[success] : " : "[failure] : ";
+	std::cout << equal << "read_at unsupported throws IOfailure" << std::endl;
+	}
+}
+
+void RecordLog_test(){
+	std::cout << "\n[RecordLog test]" << std::endl;
+	std::vector<int> test_vec = {1, 2, 3, 4};
+	std::list<short> test_list = {5, 6, 7};
+	test_iIOable test_obj(8, 9, 10, 11);
+	{
+	iFileIO log("records.log"), index("records.idx");
+	gio_record_log records(log, index);
+	int ret_int = 0;
+	std::vector<int> ret_vec;
+	std::list<short> ret_list;
+	test_iIOable ret_obj;
+	
+	records.write(42);
+	records.write(std::string("second"));
+	records.write(test_vec);
+	records.write(test_list);
+	records.write(test_obj);
+	records.read_record(0, ret_int);
+	records.read_record(2, ret_vec);
+	records.read_record(3, ret_list);
+	records.read_record(4, ret_obj);
+	std::string equal = records.count() == 5 && ret_int == 42 && records.read_record(1) == "second" && ret_vec == test_vec && ret_list == test_list && ret_obj == test_obj ? "[success] : " : "[failure] : ";
+	std::cout << equal << "write, read_record: " << records.count() << " records" << std::endl;
+	}
+	{
+	iFileIO log("records.log", false), index("records.idx", false);
+	gio_record_log records(log, index);
+	std::vector<int> ret_vec;
+	
+	records.read_record(2, ret_vec);
+	std::string equal = records.count() == 5 && ret_vec == test_vec ? "[success] : " : "[failure] : ";
+	std::cout << equal << "reopened, lazy index: " << records.count() << " records" << std::endl;
+	}
+	{
+	iFileIO log("records.log", false), index("records.idx"); // index lost
+	log.write("\x64" "abc"); // torn record, header claims 100 bytes
+	gio_record_log records(log, index);
+	
+	std::size_t recovered = records.count();
+	std::size_t n = records.write("sixth");
+	std::string equal = recovered == 5 && n == 5 && records.read_record(5) == "sixth" && records.read_record(1) == "second" ? "[success] : " : "[failure] : ";
+	std::cout << equal << "index recovered, torn record overwritten: " << records.count() << " records" << std::endl;
+	}
+	{
+	iFileIO log("records.log", false), index("records.idx", false);
+	gio_record_log records(log, index);
+	int ret_int = 0;
+	bool thrown = false;
+	try{ records.read_record(1, ret_int); } catch(iGIO::IOfailure&){ thrown = true; }
+	std::string equal = thrown && records.count() == 6 ? "[success] : " : "[failure] : ";
+	std::cout << equal << "read_record size mismatch throws IOfailure" << std::endl;
+	}
+	std::remove("records.log");
+	std::remove("records.idx");
+}
+
+void LineIndex_test(){
+	std::cout << "\n[LineIndex test]" << std::endl;
+	{
+	iFileIO text("lines.txt"), sidecar("lines.idx");
+	for(int i = 0; i < 10000; i++)
+		text.write("line" + std::to_string(i) + "\n");
+	gio_line_index index(text, sidecar, 100);
+	std::string ret_test;
+	
+	text.read_at(index.offset(1234), ret_test, 8);
+	index.seek_line(5000);
+	auto lines = text.lines();
+	std::string_view line = *lines.begin();
+	std::string equal = index.lines() == 10000 && ret_test == "line1234" && line == "line5000" ? "[success] : " : "[failure] : ";
+	std::cout << equal << "offset, seek_line: " << ret_test << ", " << line << std::endl;
+	
+	bool balanced = true;
+	auto chunks = index.chunks(4);
+	for(std::size_t i = 0; i < chunks.size(); i++){
+		std::string first;
+		text.read_at(chunks[i].begin, first, 4 + std::to_string(chunks[i].first_line).size());
+		balanced &= first == "line" + std::to_string(chunks[i].first_line) && (i == 0 || chunks[i].begin == chunks[i-1].end);
+	}
+	equal = chunks.size() == 4 && balanced && chunks.back().end == text.size() ? "[success] : " : "[failure] : ";
+	std::cout << equal << "chunks(4): first lines " << chunks[1].first_line << ", " << chunks[2].first_line << ", " << chunks[3].first_line << std::endl;
+	
+	text << "extra" << std::endl; // indexed by endl
+	ret_test.clear();
+	text.read_at(index.offset(10000), ret_test, 5);
+	equal = index.lines() == 10001 && ret_test == "extra" ? "[success] : " : "[failure] : ";
+	std::cout << equal << "endl updates index: " << index.lines() << " lines" << std::endl;
+	}
+	{
+	iFileIO text("lines.txt", false), sidecar("lines.idx", false);
+	text.write("appended\n");
+	gio_line_index index(text, sidecar, 100);
+	std::string ret_test;
+	
+	text.read_at(index.offset(10001), ret_test, 8);
+	std::string equal = index.lines() == 10002 && ret_test == "appended" ? "[success] : " : "[failure] : ";
+	std::cout << equal << "reopened sidecar: " << index.lines() << " lines" << std::endl;
+	
+	bool thrown = false;
+	try{
+		gio_line_index second(text, sidecar, 100);
+	} catch(const std::runtime_error&){
+		thrown = true;
+	}
+	text << "last" << std::endl; // still indexed by the first index
+	equal = thrown && index.lines() == 10003 ? "[success] : " : "[failure] : ";
+	std::cout << equal << "second index on the same text throws" << std::endl;
+	}
+	std::remove("lines.txt");
+	std::remove("lines.idx");
+}
+
+void ParallelReader_test(){
+	std::cout << "\n[ParallelReader test]" << std::endl;
+	std::vector<int> test;
+	for(int i = 0; i < 200000; i++){ // spans multiple ChunkBytes blocks per chunk
+		test.push_back(i);
+		file.write(std::to_string(i) + "\r\n");
+	}
+	file.write("200000"); // unterminated last record
+	test.push_back(200000);
+	auto parse = [](std::string_view record){ return std::stoi(std::string(record)); };
+	gio_thread_pool pool(4);
+	gio_parallel_reader reader(file, "\r\n", pool);
+	{
+	std::vector<int> ret_test = reader.read(parse, 7);
+	std::string equal = test == ret_test ? "[success] : " : "[failure] : ";
+	std::cout << equal << "read in order, 7 chunks: " << ret_test.size() << " records" << std::endl;
+	}
+	{
+	std::vector<std::deque<int>> ret_test = reader.read_chunks<std::deque<int>>(parse, 3);
+	bool ordered = ret_test.size() == 3;
+	int expected = 0;
+	for(auto& chunk : ret_test)
+		for(int value : chunk)
+			ordered &= value == expected++;
+	std::string equal = ordered && expected == (int)test.size() ? "[success] : " : "[failure] : ";
+	std::cout << equal << "read_chunks<std::deque<int>>: " << ret_test[0].size() << ", " << ret_test[1].size() << ", " << ret_test[2].size() << std::endl;
+	}
+	{
+	std::atomic<long long> sum{0};
+	reader.for_each([&](std::string_view record, std::size_t){ sum += parse(record); });
+	long long expected = 0;
+	for(int value : test)
+		expected += value;
+	std::string equal = sum == expected ? "[success] : " : "[failure] : ";
+	std::cout << equal << "for_each: sum " << sum << std::endl;
+	}
+	file.cleanFile();
+}
+
+// interface opting in to encoding iIOable arrays on the thread pool
+class test_parallelIO : public test_memoryIO {
+public:
+	test_parallelIO(){
+		ParallelThreshold = 16 * 1024;
+	}
+};
+
+void ParallelCodec_test(){
+	std::cout << "\n[ParallelCodec test]" << std::endl;
+	for(std::size_t size : {100, 100000}){ // below and above the ParallelThreshold
+	test_parallelIO parallel;
+	std::vector<test_iIOable> test, ret_test(size);
+	for(std::size_t i = 0; i < size; i++)
+		test.emplace_back((int)i, (int)i + 1, (int)i + 2, (int)i + 3);
+	
+	std::size_t written = parallel.write(test.data(), size);
+	std::size_t read = parallel.read(ret_test.data(), size);
+	bool equal_all = written == size && read == size && parallel.data().size() == size * 4 * sizeof(int); // encoded by toBytes(), not copied raw
+	for(std::size_t i = 0; i < size; i++)
+		equal_all &= test[i] == ret_test[i];
+	std::string equal = equal_all ? "[success] : " : "[failure] : ";
+	std::cout << equal << "iIOable array of " << size << ": " << read << " objects" << std::endl;
+	}
+}
+
+void BufferPool_test(){
+	std::cout << "\n[BufferPool test]" << std::endl;
+	gio_buffer_pool& pool = gio_buffer_pool::local();
+	std::vector<test_iIOable> test, ret_test(1000);
+	for(int i = 0; i < 1000; i++)
+		test.emplace_back(i, i, i, i);
+	{
+	file.write(test.data(), test.size());
+	file.read(ret_test.data(), ret_test.size());
+	const std::size_t allocations = pool.statistics().allocations;
+	const std::size_t reuses = pool.statistics().reuses;
+	file.write(test.data(), test.size());
+	file.read(ret_test.data(), ret_test.size());
+	file.write(test[0]);
+	file.read(ret_test[0]);
+	const auto& stats = pool.statistics();
+	std::string equal = stats.allocations == allocations && stats.reuses >= reuses + 4 && stats.in_use == 0 && stats.peak >= 1000 * 4 * sizeof(int) && stats.retained > 0 ? "[success] : " : "[failure] : ";
+	std::cout << equal << "staging buffers reused: peak " << stats.peak << ", retained " << stats.retained << ", allocations " << stats.allocations << ", reuses " << stats.reuses << std::endl;
+	file.cleanFile();
+	}
+	{
+	pool.set_limits(0, 1024);
+	file.write(test.data(), test.size());
+	file.read(ret_test.data(), ret_test.size());
+	std::string equal = pool.statistics().retained == 0 && test[999] == ret_test[999] ? "[success] : " : "[failure] : ";
+	std::cout << equal << "retained cap 0: retained " << pool.statistics().retained << std::endl;
+	pool.set_limits(16 * 1024 * 1024, 4 * 1024 * 1024);
+	file.cleanFile();
+	}
+	{
+	pool.set_limits(16 * 1024 * 1024, 1024);
+	gio_buffer_pool::buffer unpooled = pool.acquire(3000); // larger than the pooled sizes, not a class size
+	pool.set_limits(16 * 1024 * 1024, 4 * 1024 * 1024);
+	const std::size_t retained = pool.statistics().retained;
+	unpooled = gio_buffer_pool::buffer(); // released under the raised limits
+	gio_buffer_pool::buffer pooled = pool.acquire(4096);
+	std::memset(pooled.get(), 0, pooled.capacity());
+	std::string equal = pool.statistics().retained == retained && pooled.capacity() == 4096 ? "[success] : " : "[failure] : ";
+	std::cout << equal << "buffer acquired unpooled is freed after raising the limits" << std::endl;
+	}
+}
+
+void DirectIO_test(){
+	std::cout << "\n[DirectIO test]" << std::endl;
+	std::vector<int> test(300000);
+	for(std::size_t i = 0; i < test.size(); i++)
+		test[i] = (int)i;
+	{
+	iFileIO direct("direct.bin");
+	direct.write(std::string_view("head")); // the staging buffer starts at an unaligned offset
+	const bool enabled = direct.direct_io();
+	for(std::size_t i = 0; i < test.size(); i += 777)
+		direct.write(test.data() + i, std::min<std::size_t>(777, test.size() - i));
+	const std::uint64_t staged_size = direct.size(); // counts staged bytes without writing them
+	direct << std::flush; // reads see the staged tail after a flush
+	std::vector<int> ret_test(test.size());
+	direct.read_at(4, ret_test.data(), ret_test.size());
+	std::string equal = staged_size == 4 + test.size() * sizeof(int) && direct.size() == staged_size && test == ret_test ? "[success] : " : "[failure] : ";
+	std::cout << equal << "direct writes read back, " << (enabled ? "O_DIRECT" : "buffered fallback") << ", size " << direct.size() << std::endl;
+	direct.write(test.data(), 3); // an unaligned tail finalized by the destructor
+	}
+	{
+	iFileIO direct("direct.bin", false);
+	std::vector<int> ret_test(3);
+	direct.read_at(4 + test.size() * sizeof(int), ret_test.data(), 3);
+	const bool enabled = direct.direct_io();
+	direct.write(test.data(), 5);
+	direct.direct_io(false);
+	direct.write(test.data(), 1);
+	std::vector<int> tail(6);
+	direct.read_at(4 + (test.size() + 3) * sizeof(int), tail.data(), 6);
+	std::string equal = std::equal(ret_test.begin(), ret_test.end(), test.begin()) && std::equal(tail.begin(), tail.begin() + 5, test.begin()) && tail[5] == 0 && !direct.direct_io(false)
+		&& direct.size() == 4 + (test.size() + 9) * sizeof(int) ? "[success] : " : "[failure] : ";
+	std::cout << equal << "tail finalized on close and on disable, reopened " << (enabled ? "O_DIRECT" : "buffered fallback") << std::endl;
+	}
+	// megabytes written per second since start
+	auto throughput = [](const std::size_t bytes, const std::chrono::steady_clock::time_point start){
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		return bytes / 1e6 / std::max(seconds, 1e-9);
+	};
+	for(const bool use_direct : {true, false}){
+	iFileIO direct("direct.bin");
+	const bool enabled = use_direct && direct.direct_io();
+	const auto start = std::chrono::steady_clock::now();
+	for(int i = 0; i < 16; i++)
+		direct.write(test.data(), test.size());
+	direct << std::flush;
+	const double write_mbs = throughput(16 * test.size() * sizeof(int), start);
+	std::string equal = direct.size() == 16 * test.size() * sizeof(int) ? "[success] : " : "[failure] : ";
+	std::cout << equal << (enabled ? "O_DIRECT" : "buffered") << " write " << std::fixed << std::setprecision(0) << write_mbs << " MB/s" << std::defaultfloat << std::setprecision(6) << std::endl;
+	}
+	std::remove("direct.bin");
+}
+
+void Durability_test(){
+	std::cout << "\n[Durability test]" << std::endl;
+	{
+	iFileIO log("durable.log");
+	log.set_durability(iFileIO::durability::flush);
+	for(int i = 0; i < 3; i++)
+		log << "entry" << std::endl;
+	log << std::flush;
+	std::string equal = log.syncs() == 4 && log.size() == 3 * 6 ? "[success] : " : "[failure] : ";
+	std::cout << equal << "flush mode: " << log.syncs() << " syncs for 4 flushes" << std::endl;
+	}
+	{
+	iFileIO log("durable.log");
+	log.set_durability(iFileIO::durability::group_commit);
+	const int threads = 8, lines = 50;
+	std::vector<std::thread> writers;
+	for(int t = 0; t < threads; t++)
+		writers.emplace_back([&log, t]{
+			const std::string line = "writer " + std::to_string(t) + "\n";
+			for(int i = 0; i < lines; i++){
+				log.write(std::string_view(line));
+				log << std::flush;
+			}
+		});
+	for(auto& writer : writers)
+		writer.join();
+	std::size_t count = 0;
+	for(std::string_view line : log.lines())
+		count += line.rfind("writer ", 0) == 0;
+	std::string equal = count == threads * lines && log.syncs() >= 1 && log.syncs() <= threads * lines ? "[success] : " : "[failure] : ";
+	std::cout << equal << "group commit: " << log.syncs() << " syncs for " << threads * lines << " flushes" << std::endl;
+	}
+	{
+	iFileIO log("durable.log");
+	log.set_durability(iFileIO::durability::periodic, std::chrono::milliseconds(5));
+	log.write(std::string_view("entry\n"));
+	for(int i = 0; i < 200 && !log.syncs(); i++)
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	std::string equal = log.syncs() >= 1 ? "[success] : " : "[failure] : ";
+	std::cout << equal << "periodic: synced in the background" << std::endl;
+	log.set_durability(iFileIO::durability::none);
+	}
+	{
+	iFileIO src("durable_src.log"), log("durable.log");
+	src << "transferred entry" << std::endl;
+	log.set_durability(iFileIO::durability::group_commit);
+	const std::size_t n = transfer(src, log);
+	log << std::flush;
+	std::string equal = n == 18 && log.syncs() == 1 && log.size() == 18 ? "[success] : " : "[failure] : ";
+	std::cout << equal << "group commit: transfer() synced by flush, " << log.syncs() << " syncs" << std::endl;
+	}
+	std::remove("durable_src.log");
+	std::remove("durable.log");
+}
+
+class test_hintIO : public test_memoryIO {
+public:
+	std::vector<std::uint64_t> reserved;
+protected:
+	virtual void iReserve(const std::uint64_t bytes) override{
+		reserved.push_back(bytes);
+	}
+};
+
+void Hints_test(){
+	std::cout << "\n[Hints test]" << std::endl;
+	{
+	test_hintIO hinted;
+	std::vector<int> large(100000, 1), small(10, 1);
+	std::list<int> list(large.begin(), large.end());
+	std::vector<std::vector<int>> rows(4, large);
+	hinted.write(small);
+	hinted.write(large);
+	hinted.write(list);
+	hinted.write(rows);
+	hinted.write(large.begin(), large.end());
+	const std::uint64_t bytes = large.size() * sizeof(int);
+	const std::vector<std::uint64_t> expected = {bytes, bytes, 4 * bytes, bytes};
+	std::string equal = hinted.reserved == expected ? "[success] : " : "[failure] : ";
+	std::cout << equal << "bulk writes pass their size to iReserve, " << hinted.reserved.size() << " hints" << std::endl;
+	}
+	struct stat st;
+	const std::uint64_t expected_size = 8 * 1024 * 1024;
+	std::vector<char> data(100000, 'x');
+	bool preallocated = false;
+	{
+	iFileIO hinted("hints.bin");
+	preallocated = hinted.expect_size(expected_size);
+	hinted.write(data);
+	hinted.advise(iGIO::access_pattern::sequential);
+	::stat("hints.bin", &st);
+	std::string equal = hinted.size() == data.size() && (!preallocated || (std::uint64_t)st.st_blocks * 512 >= expected_size) ? "[success] : " : "[failure] : ";
+	std::cout << equal << "expect_size " << (preallocated ? "preallocated " : "unsupported, allocated ") << st.st_blocks * 512 << " bytes, size " << hinted.size() << std::endl;
+	}
+	{
+	::stat("hints.bin", &st);
+	std::string equal = (std::uint64_t)st.st_size == data.size() && (std::uint64_t)st.st_blocks * 512 < expected_size ? "[success] : " : "[failure] : ";
+	std::cout << equal << "preallocation trimmed on close to " << st.st_blocks * 512 << " bytes" << std::endl;
+	}
+	std::remove("hints.bin");
+}
+
+void CachedIO_test(){
+	std::cout << "\n[CachedIO test]" << std::endl;
+	std::vector<int> test(64 * 1024);
+	for(std::size_t i = 0; i < test.size(); i++)
+		test[i] = (int)i;
+	iFileIO backing("cached.bin");
+	backing.write(test);
+	{
+	iCachedIO cached(backing, 1024 * 1024, 4096, 4);
+	bool equal_reads = true;
+	for(int pass = 0; pass < 2; pass++)
+		for(std::size_t i = 0; i < test.size(); i += 997){
+			int value = -1;
+			cached.read_at(i * sizeof(int), value);
+			equal_reads &= value == test[i];
+		}
+	auto stats = cached.statistics();
+	const std::uint64_t blocks = test.size() * sizeof(int) / 4096;
+	std::string equal = equal_reads && stats.misses == blocks && stats.hits == 2 * ((test.size() + 996) / 997) - blocks ? "[success] : " : "[failure] : ";
+	std::cout << equal << "repeated reads: " << stats.hits << " hits, " << stats.misses << " misses" << std::endl;
+	}
+	{
+	iCachedIO cached(backing, 1024 * 1024, 4096, 4);
+	int value = 0;
+	cached.read_at(100 * sizeof(int), value);
+	std::vector<int> tail;
+	cached.read_at((test.size() - 1) * sizeof(int), tail, 2); // caches the last block and the empty block after it
+	tail.clear();
+	cached.write_at(100 * sizeof(int), -100);
+	cached.write(-1);
+	cached.read_at(100 * sizeof(int), value);
+	cached.read_at((test.size() - 1) * sizeof(int), tail, 2);
+	std::string equal = value == -100 && tail.size() == 2 && tail[0] == test.back() && tail[1] == -1 && cached.statistics().invalidations >= 1 ? "[success] : " : "[failure] : ";
+	std::cout << equal << "writes invalidate cached blocks: " << value << ", " << tail[1] << std::endl;
+	std::vector<int> sequential;
+	cached.read(sequential);
+	sequential[100] = 100;
+	equal = sequential.size() == test.size() + 1 && std::equal(test.begin(), test.end(), sequential.begin()) && sequential.back() == -1 ? "[success] : " : "[failure] : ";
+	std::cout << equal << "sequential read through the cache" << std::endl;
+	}
+	{
+	iCachedIO cached(backing, 16 * 4096, 4096, 4);
+	std::atomic<bool> equal_reads{true};
+	gio_thread_pool::shared().parallel_for(64, [&](std::size_t t){
+		for(std::size_t i = t * 31; i < test.size(); i += 509){
+			int value = 0;
+			cached.read_at(i * sizeof(int), value);
+			if(value != (i == 100 ? -100 : test[i]))
+				equal_reads = false;
+		}
+	});
+	auto stats = cached.statistics();
+	std::string equal = equal_reads && stats.evictions > 0 ? "[success] : " : "[failure] : ";
+	std::cout << equal << "concurrent reads with evictions: " << stats.hits << " hits, " << stats.misses << " misses, " << stats.evictions << " evictions" << std::endl;
+	}
+	std::remove("cached.bin");
+}
+
+// flips the bits of every byte with a key
+class test_xor_filter : public gio_filter {
+	const char _key;
+	char _staging[256];
+public:
+	explicit test_xor_filter(const char key) : _key(key) {}
+	std::size_t write(const char* data, const std::size_t length, stage& next) override{
+		for(std::size_t n = 0; n < length;){
+			const std::size_t k = std::min(length - n, sizeof(_staging));
+			for(std::size_t i = 0; i < k; i++)
+				_staging[i] = data[n + i] ^ _key;
+			next.write(_staging, k);
+			n += k;
+		}
+		return length;
+	}
+	std::size_t read(char* buffer, const std::size_t length, stage& next) override{
+		const std::size_t n = next.read(buffer, length);
+		for(std::size_t i = 0; i < n; i++)
+			buffer[i] ^= _key;
+		return n;
+	}
+};
+
+// collects written bytes into frames with a std::uint32_t length header, a frame ends on flush()
+class test_frame_filter : public gio_filter {
+	std::string _pending, _frame;
+	std::size_t _frame_pos = 0;
+public:
+	std::size_t frames = 0;
+	std::size_t write(const char* data, const std::size_t length, stage& next) override{
+		(void)next;
+		_pending.append(data, length);
+		return length;
+	}
+	void flush(stage& next) override{
+		if(!_pending.empty()){
+			const std::uint32_t header = (std::uint32_t)_pending.size();
+			next.write((const char*)&header, sizeof(header));
+			next.write(_pending.data(), _pending.size());
+			_pending.clear();
+			frames++;
+		}
+		next.flush();
+	}
+	std::size_t read(char* buffer, const std::size_t length, stage& next) override{
+		if(_frame_pos == _frame.size()){
+			std::uint32_t header = 0;
+			if(next.read((char*)&header, sizeof(header)) != sizeof(header))
+				return 0;
+			_frame.resize(header);
+			_frame.resize(next.read(_frame.data(), header));
+			_frame_pos = 0;
+		}
+		const std::size_t n = std::min(length, _frame.size() - _frame_pos);
+		std::memcpy(buffer, _frame.data() + _frame_pos, n);
+		_frame_pos += n;
+		return n;
+	}
+};
+
+void Filter_test(){
+	std::cout << "\n[Filter test]" << std::endl;
+	std::vector<int> test(10000);
+	for(std::size_t i = 0; i < test.size(); i++)
+		test[i] = (int)i;
+	{
+	iFileIO filtered("filtered.bin");
+	test_frame_filter& frames = filtered.add_filter<test_frame_filter>();
+	filtered.add_filter<test_xor_filter>((char)0x5A);
+	filtered.write(test);
+	filtered << std::flush;
+	filtered << "first line" << std::endl;
+	filtered.write(std::string_view("unflushed"));
+	const std::size_t flushed_frames = frames.frames;
+	filtered.remove_filters();
+	std::uint32_t header = 0;
+	filtered.read(header);
+	std::string equal = flushed_frames == 2 && filtered.filter_count() == 0 && (header ^ 0x5A5A5A5A) == test.size() * sizeof(int)
+		&& filtered.size() == 3 * sizeof(header) + test.size() * sizeof(int) + 11 + 9 ? "[success] : " : "[failure] : ";
+	std::cout << equal << "frames written on flush, endl and remove_filters: " << filtered.size() << " bytes" << std::endl;
+	}
+	{
+	iFileIO filtered("filtered.bin", false);
+	filtered.add_filter<test_frame_filter>();
+	filtered.add_filter<test_xor_filter>((char)0x5A);
+	std::vector<int> ret_test(test.size());
+	std::string line, rest;
+	filtered.read(ret_test.data(), ret_test.size());
+	filtered.read_until(line, '\n');
+	filtered.read(rest);
+	std::string equal = test == ret_test && line == "first line\n" && rest == "unflushed" ? "[success] : " : "[failure] : ";
+	std::cout << equal << "read back through the filters: " << line.substr(0, 10) << ", " << rest << std::endl;
+	bool threw = false;
+	try{
+		filtered.read_at(0, line, 4);
+	} catch(const iGIO::IOfailure& e){
+		threw = true;
+	}
+	equal = threw ? "[success] : " : "[failure] : ";
+	std::cout << equal << "positional access throws while filters are attached" << std::endl;
+	}
+	{
+	iFileIO filtered("filtered.bin", false), plain("filtered_plain.bin");
+	filtered.add_filter<test_frame_filter>();
+	filtered.add_filter<test_xor_filter>((char)0x5A);
+	std::size_t n = transfer(filtered, plain); // must not copy the encoded bytes with the kernel
+	std::vector<int> ret_test(test.size());
+	plain.read(ret_test.data(), ret_test.size());
+	std::string equal = n == test.size() * sizeof(int) + 11 + 9 && test == ret_test ? "[success] : " : "[failure] : ";
+	std::cout << equal << "transfer decodes filtered source: " << n << " bytes" << std::endl;
+	}
+	// megabytes written per second since start
+	auto throughput = [](const std::size_t bytes, const std::chrono::steady_clock::time_point start){
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		return bytes / 1e6 / std::max(seconds, 1e-9);
+	};
+	{
+	test_memoryIO bare, emptied;
+	emptied.add_filter<test_xor_filter>((char)0x5A);
+	emptied.remove_filters(); // the chain is empty again
+	auto start = std::chrono::steady_clock::now();
+	for(int i = 0; i < 100; i++)
+		for(const int element : test) // per element writes measure the per call overhead
+			bare.write(element);
+	const double bare_mbs = throughput(100 * test.size() * sizeof(int), start);
+	start = std::chrono::steady_clock::now();
+	for(int i = 0; i < 100; i++)
+		for(const int element : test)
+			emptied.write(element);
+	const double emptied_mbs = throughput(100 * test.size() * sizeof(int), start);
+	std::string equal = bare.data() == emptied.data() && emptied.filter_count() == 0 ? "[success] : " : "[failure] : ";
+	std::cout << equal << "per element writes, bare backend " << std::fixed << std::setprecision(0) << bare_mbs << " MB/s, empty filter chain "
+		<< emptied_mbs << " MB/s" << std::defaultfloat << std::setprecision(6) << std::endl;
+	}
+	std::remove("filtered.bin");
+	std::remove("filtered_plain.bin");
+}
+
+void LZ_test(){
+	std::cout << "\n[LZ test]" << std::endl;
+	std::vector<test_struct> test;
+	for(int i = 0; i < 20000; i++)
+		test.push_back(test_struct{i % 7, 50, i % 3, 100});
+	std::string noise(100000, 0);
+	for(std::size_t i = 0; i < noise.size(); i++)
+		noise[i] = (char)(i * 2654435761u >> 13);
+	// megabytes of uncompressed data per second since start
+	auto throughput = [](const std::size_t bytes, const std::chrono::steady_clock::time_point start){
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		return bytes / 1e6 / std::max(seconds, 1e-9);
+	};
+	for(int level : {0, 1, 6}){
+	{
+	iFileIO compressed("compressed.bin");
+	gio_lz_filter& lz = compressed.add_filter<gio_lz_filter>(level);
+	const auto start = std::chrono::steady_clock::now();
+	for(const test_struct& element : test) // per element writes are collected into blocks
+		compressed.write(element);
+	compressed << "end" << std::endl;
+	compressed.write(noise);
+	compressed << std::flush; // writes the last block, the filter is destroyed by remove_filters()
+	const gio_lz_filter::stats stats = lz.statistics();
+	const double write_mbs = throughput(stats.raw, start);
+	compressed.remove_filters();
+	const double ratio = (double)stats.raw / stats.stored;
+	std::string equal = compressed.size() == stats.stored && (level ? ratio > 2 : ratio <= 1) ? "[success] : " : "[failure] : ";
+	std::cout << equal << "level " << level << ": " << stats.raw << " bytes stored in " << stats.stored << " bytes, " << stats.blocks << " blocks, ratio "
+		<< std::fixed << std::setprecision(2) << ratio << ", write " << std::setprecision(0) << write_mbs << " MB/s" << std::defaultfloat << std::setprecision(6) << std::endl;
+	}
+	{
+	iFileIO compressed("compressed.bin", false);
+	compressed.add_filter<gio_lz_filter>(level);
+	std::vector<test_struct> ret_test(test.size());
+	std::string end, ret_noise(noise.size(), 0);
+	const auto start = std::chrono::steady_clock::now();
+	compressed.read(ret_test.data(), ret_test.size());
+	compressed.read_until(end, '\n');
+	const std::size_t n = compressed.read(ret_noise.data(), ret_noise.size());
+	const double read_mbs = throughput(ret_test.size() * sizeof(test_struct) + end.size() + n, start);
+	std::string equal = std::equal(test.begin(), test.end(), ret_test.begin()) && end == "end\n" && n == noise.size() && noise == ret_noise ? "[success] : " : "[failure] : ";
+	std::cout << equal << "level " << level << " read back: " << ret_test.size() << " elements, " << n << " incompressible bytes, read "
+		<< std::fixed << std::setprecision(0) << read_mbs << " MB/s" << std::defaultfloat << std::setprecision(6) << std::endl;
+	}
+	}
+	{
+	iFileIO compressed("compressed.bin", false);
+	compressed.write_at(20, 'X'); // inside the compressed bytes of the first block
+	compressed.add_filter<gio_lz_filter>();
+	std::vector<test_struct> ret_test(test.size());
+	bool threw = false;
+	try{
+		compressed.read(ret_test.data(), ret_test.size());
+	} catch(const iGIO::IOfailure& e){
+		threw = true;
+	}
+	std::string equal = threw || !std::equal(test.begin(), test.end(), ret_test.begin()) ? "[success] : " : "[failure] : ";
+	std::cout << equal << "corrupt block detected" << std::endl;
+	}
+	std::remove("compressed.bin");
+}
+
+void CRC32C_test(){
+	std::cout << "\n[CRC32C test]" << std::endl;
+	{
+	const std::string_view check = "123456789";
+	const std::uint32_t crc = gio_crc32c::compute(check.data(), check.size());
+	const std::uint32_t chained = gio_crc32c::compute(check.data() + 4, 5, gio_crc32c::compute(check.data(), 4));
+	std::string equal = crc == 0xE3069283 && chained == crc && gio_crc32c::compute_portable(check.data(), check.size()) == crc ? "[success] : " : "[failure] : ";
+	std::cout << equal << "check value " << std::hex << crc << std::dec << (gio_crc32c::accelerated() ? ", crc32 instruction" : ", slicing-by-8") << std::endl;
+	std::string noise(100003, 0);
+	for(std::size_t i = 0; i < noise.size(); i++)
+		noise[i] = (char)(i * 2654435761u >> 13);
+	equal = gio_crc32c::compute(noise.data(), noise.size()) == gio_crc32c::compute_portable(noise.data(), noise.size()) ? "[success] : " : "[failure] : ";
+	std::cout << equal << "accelerated and portable agree" << std::endl;
+	}
+	std::vector<test_struct> test;
+	for(int i = 0; i < 300; i++)
+		test.push_back(test_struct{i, 50, i % 3, 100});
+	{
+	iFileIO checked("checked.bin");
+	checked.add_filter<gio_crc32c_filter>(1024);
+	checked.write(test);
+	checked << "end" << std::endl;
+	checked.remove_filters();
+	}
+	{
+	iFileIO checked("checked.bin", false);
+	checked.add_filter<gio_crc32c_filter>(1024);
+	std::vector<test_struct> ret_test(test.size());
+	std::string end;
+	checked.read(ret_test.data(), ret_test.size());
+	checked.read_until(end, '\n');
+	std::string equal = std::equal(test.begin(), test.end(), ret_test.begin()) && end == "end\n" ? "[success] : " : "[failure] : ";
+	std::cout << equal << ret_test.size() << " elements verified in " << checked.size() << " bytes" << std::endl;
+	}
+	{
+	iFileIO checked("checked.bin", false);
+	checked.write_at(1032 + 100, 'X'); // inside the second block, which starts after 4 + 1024 + 4 bytes
+	checked.add_filter<gio_crc32c_filter>(1024);
+	std::vector<test_struct> ret_test(test.size());
+	std::string message;
+	try{
+		checked.read(ret_test.data(), ret_test.size());
+	} catch(const iGIO::IOfailure& e){
+		message = e.what();
+	}
+	std::string equal = message.find("offset 1032") != std::string::npos ? "[success] : " : "[failure] : ";
+	std::cout << equal << "corruption reported: " << message << std::endl;
+	}
+	{
+	iFileIO checked("checked.bin");
+	checked.add_filter<gio_lz_filter>();
+	checked.add_filter<gio_crc32c_filter>();
+	checked.write(test);
+	checked.remove_filters();
+	checked.add_filter<gio_lz_filter>();
+	checked.add_filter<gio_crc32c_filter>();
+	std::vector<test_struct> ret_test(test.size());
+	const std::size_t n = checked.read(ret_test.data(), ret_test.size());
+	std::string equal = n == test.size() && std::equal(test.begin(), test.end(), ret_test.begin()) ? "[success] : " : "[failure] : ";
+	std::cout << equal << "stacked under compression: " << checked.size() << " bytes" << std::endl;
+	}
+	{
+	test_memoryIO memory;
+	memory.add_filter<gio_crc32c_filter>();
+	memory.write(std::string_view("first block"));
+	memory << std::flush;
+	memory.write(std::string_view("pending")); // kept by the filter while reading
+	std::string ret_test, rest;
+	memory.read(ret_test, 5);
+	memory << std::flush;
+	memory.read(rest, 13);
+	std::string equal = ret_test == "first" && rest == " blockpending" && memory.data().size() == 2 * 8 + 11 + 7 ? "[success] : " : "[failure] : ";
+	std::cout << equal << "interleaved write, read and flush: " << memory.data().size() << " bytes" << std::endl;
+	}
+	std::remove("checked.bin");
+}
+
+void ChaCha20_test(){
+	std::cout << "\n[ChaCha20-Poly1305 test]" << std::endl;
+	gio_chacha20_filter::key_type key;
+	for(std::size_t i = 0; i < key.size(); i++)
+		key[i] = (std::uint8_t)(0x80 + i);
+	{ // RFC 8439 section 2.8.2
+	const std::uint8_t nonce[12] = {0x07, 0, 0, 0, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47};
+	const std::uint8_t aad[12] = {0x50, 0x51, 0x52, 0x53, 0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7};
+	const std::uint8_t expected_start[8] = {0xd3, 0x1a, 0x8d, 0x34, 0x64, 0x8e, 0x60, 0xdb};
+	const std::uint8_t expected_tag[16] = {0x1a, 0xe1, 0x0b, 0x59, 0x4f, 0x09, 0xe2, 0x6a, 0x7e, 0x90, 0x2e, 0xcb, 0xd0, 0x60, 0x06, 0x91};
+	const std::string plain = "Ladies and Gentlemen of the class of '99: If I could offer you only one tip for the future, sunscreen would be it.";
+	std::string data = plain;
+	std::uint8_t tag[16];
+	gio_chacha20_filter::seal(key, nonce, aad, sizeof(aad), data.data(), data.size(), tag);
+	const bool sealed = std::equal(std::begin(expected_start), std::end(expected_start), (const std::uint8_t*)data.data()) && std::equal(std::begin(tag), std::end(tag), expected_tag);
+	const bool opened = gio_chacha20_filter::open(key, nonce, aad, sizeof(aad), data.data(), data.size(), tag) && data == plain;
+	gio_chacha20_filter::seal(key, nonce, aad, sizeof(aad), data.data(), data.size(), tag);
+	const bool rejected = !gio_chacha20_filter::open(key, nonce, aad, 4, data.data(), data.size(), tag); // different authenticated data
+	std::string equal = sealed && opened && rejected ? "[success] : " : "[failure] : ";
+	std::cout << equal << "RFC 8439 vector, " << gio_chacha20_filter::implementation() << std::endl;
+	
+	// 1000 bytes reach the 8 block, 4 block and scalar paths, expected values computed with OpenSSL's EVP_chacha20_poly1305
+	const std::uint8_t expected_long_tag[16] = {0x44, 0x92, 0xeb, 0x14, 0x35, 0x74, 0xbb, 0xf8, 0x8c, 0x1a, 0x5d, 0x76, 0xd1, 0xb3, 0x66, 0xb6};
+	const std::uint8_t expected_at_448[8] = {0x36, 0x66, 0xff, 0x4b, 0x40, 0xd2, 0xf5, 0x6d}; // the high lanes of the 8 block path
+	const std::uint8_t expected_at_768[8] = {0x18, 0xe4, 0x86, 0x51, 0x50, 0x54, 0xd2, 0xff}; // the scalar path
+	std::string long_plain(1000, 0);
+	for(std::size_t i = 0; i < long_plain.size(); i++)
+		long_plain[i] = (char)(i * 7 + 3);
+	std::string long_data = long_plain;
+	gio_chacha20_filter::seal(key, nonce, aad, sizeof(aad), long_data.data(), long_data.size(), tag);
+	const std::uint8_t* ciphertext = (const std::uint8_t*)long_data.data();
+	const bool long_sealed = std::equal(std::begin(tag), std::end(tag), expected_long_tag) && gio_crc32c::compute(ciphertext, long_data.size()) == 0x388108ff
+		&& std::equal(std::begin(expected_at_448), std::end(expected_at_448), ciphertext + 448) && std::equal(std::begin(expected_at_768), std::end(expected_at_768), ciphertext + 768);
+	const bool long_opened = gio_chacha20_filter::open(key, nonce, aad, sizeof(aad), long_data.data(), long_data.size(), tag) && long_data == long_plain;
+	equal = long_sealed && long_opened ? "[success] : " : "[failure] : ";
+	std::cout << equal << "1000 byte vector" << std::endl;
+	}
+	std::vector<test_struct> test;
+	for(int i = 0; i < 300; i++)
+		test.push_back(test_struct{i, 50, i % 3, 100});
+	{
+	iFileIO encrypted("encrypted.bin");
+	encrypted.add_filter<gio_chacha20_filter>(key, 1000);
+	encrypted.write(test);
+	encrypted << "end" << std::endl;
+	encrypted.remove_filters();
+	std::vector<test_struct> raw(test.size());
+	encrypted.read(raw.data(), raw.size());
+	std::string equal = !std::equal(test.begin(), test.end(), raw.begin()) ? "[success] : " : "[failure] : ";
+	std::cout << equal << "stored encrypted in " << encrypted.size() << " bytes" << std::endl;
+	}
+	{
+	iFileIO encrypted("encrypted.bin", false);
+	encrypted.add_filter<gio_chacha20_filter>(key, 1000);
+	std::vector<test_struct> ret_test(test.size());
+	std::string end;
+	encrypted.read(ret_test.data(), ret_test.size());
+	encrypted.read_until(end, '\n');
+	std::string equal = std::equal(test.begin(), test.end(), ret_test.begin()) && end == "end\n" ? "[success] : " : "[failure] : ";
+	std::cout << equal << ret_test.size() << " elements decrypted" << std::endl;
+	}
+	{
+	iFileIO encrypted("encrypted.bin", false);
+	std::string stored;
+	encrypted.read(stored, encrypted.size());
+	auto truncation_detected = [&key](const std::string& bytes){
+		test_memoryIO memory;
+		memory.write(std::string_view(bytes));
+		memory.add_filter<gio_chacha20_filter>(key, 1000);
+		std::string all(bytes.size(), 0);
+		try{
+			memory.read(all.data(), all.size()); // reads up to the end of the stream
+		} catch(const iGIO::IOfailure& e){
+			return std::string(e.what()).find("truncated") != std::string::npos;
+		}
+		return false;
+	};
+	const bool complete = !truncation_detected(stored);
+	const bool without_end = truncation_detected(stored.substr(0, stored.size() - 20)); // the empty end block
+	const bool without_last = truncation_detected(stored.substr(0, stored.size() - 20 - 20 - (test.size() * sizeof(test_struct) + 4) % 1000));
+	std::string equal = complete && without_end && without_last ? "[success] : " : "[failure] : ";
+	std::cout << equal << "truncation at a block boundary detected" << std::endl;
+	}
+	{
+	iFileIO encrypted("encrypted.bin", false);
+	gio_chacha20_filter::key_type wrong = key;
+	wrong[31] ^= 1;
+	encrypted.add_filter<gio_chacha20_filter>(wrong, 1000);
+	std::vector<test_struct> ret_test(test.size());
+	bool threw = false;
+	try{
+		encrypted.read(ret_test.data(), ret_test.size());
+	} catch(const iGIO::IOfailure& e){
+		threw = true;
+	}
+	std::string equal = threw ? "[success] : " : "[failure] : ";
+	std::cout << equal << "wrong key rejected" << std::endl;
+	}
+	{
+	iFileIO encrypted("encrypted.bin", false);
+	char byte = 0;
+	encrypted.read_at(8 + 1020 + 10, byte);
+	encrypted.write_at(8 + 1020 + 10, (char)(byte ^ 1)); // inside the second block, after the salt and the first block
+	encrypted.add_filter<gio_chacha20_filter>(key, 1000);
+	std::vector<test_struct> ret_test(test.size());
+	std::string message;
+	try{
+		encrypted.read(ret_test.data(), ret_test.size());
+	} catch(const iGIO::IOfailure& e){
+		message = e.what();
+	}
+	std::string equal = message.find("offset 1028") != std::string::npos ? "[success] : " : "[failure] : ";
+	std::cout << equal << "tampering reported: " << message << std::endl;
+	}
+	{
+	iFileIO encrypted("encrypted.bin");
+	encrypted.add_filter<gio_lz_filter>();
+	encrypted.add_filter<gio_chacha20_filter>(key);
+	encrypted.write(test);
+	encrypted.remove_filters();
+	encrypted.add_filter<gio_lz_filter>();
+	encrypted.add_filter<gio_chacha20_filter>(key);
+	std::vector<test_struct> ret_test(test.size());
+	const std::size_t n = encrypted.read(ret_test.data(), ret_test.size());
+	std::string equal = n == test.size() && std::equal(test.begin(), test.end(), ret_test.begin()) ? "[success] : " : "[failure] : ";
+	std::cout << equal << "compressed then encrypted: " << encrypted.size() << " bytes" << std::endl;
+	}
+	{
+	for(const char* segment : {"first segment\n", "appended segment\n"}){
+		iFileIO encrypted("encrypted.bin", segment[0] == 'f'); // the second opening appends
+		encrypted.add_filter<gio_chacha20_filter>(key);
+		encrypted << segment;
+		encrypted.remove_filters();
+	}
+	iFileIO encrypted("encrypted.bin", false);
+	encrypted.add_filter<gio_chacha20_filter>(key);
+	std::string all(64, 0);
+	all.resize(encrypted.read(all.data(), all.size()));
+	std::string equal = all == "first segment\nappended segment\n" && encrypted.size() == 2 * (8 + 20 + 20) + all.size() ? "[success] : " : "[failure] : ";
+	std::cout << equal << "appended segment read after the first: " << encrypted.size() << " bytes" << std::endl;
+	}
+	{
+	test_memoryIO memory;
+	memory.add_filter<gio_chacha20_filter>(key);
+	memory.write(std::string_view("first block"));
+	memory << std::flush;
+	memory.write(std::string_view("pending")); // kept by the filter while reading
+	std::string ret_test, rest;
+	memory.read(ret_test, 5);
+	memory << std::flush;
+	memory.read(rest, 13);
+	std::string equal = ret_test == "first" && rest == " blockpending" && memory.data().size() == 8 + 2 * 20 + 11 + 7 ? "[success] : " : "[failure] : ";
+	std::cout << equal << "interleaved write, read and flush: " << memory.data().size() << " bytes" << std::endl;
+	}
+	{
+	// megabytes of plaintext per second since start
+	auto throughput = [](const std::size_t bytes, const std::chrono::steady_clock::time_point start){
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		return bytes / 1e6 / std::max(seconds, 1e-9);
+	};
+	std::string plain(16 * 1024 * 1024, 0);
+	for(std::size_t i = 0; i < plain.size(); i++)
+		plain[i] = (char)(i * 2654435761u >> 13);
+	test_memoryIO memory;
+	memory.add_filter<gio_chacha20_filter>(key);
+	auto start = std::chrono::steady_clock::now();
+	memory.write(std::string_view(plain));
+	memory.remove_filters();
+	const double encrypt_mbs = throughput(plain.size(), start);
+	memory.add_filter<gio_chacha20_filter>(key);
+	std::string ret_plain(plain.size(), 0);
+	start = std::chrono::steady_clock::now();
+	const std::size_t n = memory.read(ret_plain.data(), ret_plain.size());
+	const double decrypt_mbs = throughput(n, start);
+	std::string equal = n == plain.size() && plain == ret_plain ? "[success] : " : "[failure] : ";
+	std::cout << equal << gio_chacha20_filter::implementation() << ": encrypt " << std::fixed << std::setprecision(0) << encrypt_mbs << " MB/s, decrypt "
+		<< decrypt_mbs << " MB/s" << std::defaultfloat << std::setprecision(6) << std::endl;
+	}
+	std::remove("encrypted.bin");
+}
+
+void Varint_test(){
+	std::cout << "\n[Varint test]" << std::endl;
+	std::vector<std::int64_t> timestamps;
+	for(std::int64_t i = 0, t = 1700000000000; i < 10000; i++, t += 1 + i % 50)
+		timestamps.push_back(t);
+	std::vector<int> signed_values = {0, -1, 1, -64, 63, -65, 64, std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), -123456789};
+	std::vector<std::uint64_t> unsigned_values = {0, 127, 128, 16383, 16384, std::numeric_limits<std::uint64_t>::max(), 300};
+	std::vector<std::int8_t> bytes = {-128, 127, -1, 0, 5};
+	std::deque<std::uint16_t> descending = {65535, 60000, 3, 2, 1, 0};
+	{
+	const std::size_t written = file.write_varint(timestamps, true);
+	const std::size_t encoded = file.size();
+	file.write_varint(signed_values);
+	file.write_varint(unsigned_values.begin(), unsigned_values.end());
+	file.write_varint(bytes, true);
+	file.write_varint(descending, true);
+	file << "end" << std::endl;
+	std::string equal = written == timestamps.size() && encoded < timestamps.size() * 2 ? "[success] : " : "[failure] : ";
+	std::cout << equal << timestamps.size() << " delta coded timestamps in " << encoded << " bytes instead of " << timestamps.size() * sizeof(std::int64_t) << std::endl;
+	}
+	{
+	std::vector<std::int64_t> ret_timestamps;
+	std::vector<int> ret_signed;
+	std::list<std::uint64_t> ret_unsigned;
+	std::vector<std::int8_t> ret_bytes;
+	std::deque<std::uint16_t> ret_descending;
+	std::string end;
+	file.read_varint(ret_timestamps);
+	file.read_varint(ret_signed);
+	file.read_varint(ret_unsigned);
+	file.read_varint(ret_bytes);
+	file.read_varint(ret_descending);
+	file.read_until(end, '\n');
+	std::string equal = ret_timestamps == timestamps && ret_signed == signed_values && std::equal(unsigned_values.begin(), unsigned_values.end(), ret_unsigned.begin())
+		&& ret_bytes == bytes && ret_descending == descending && end == "end\n" ? "[success] : " : "[failure] : ";
+	std::cout << equal << "read back: ";
+	print_arr(ret_signed.data(), ret_signed.size());
+	file.cleanFile();
+	}
+	{
+	std::vector<std::uint32_t> small(1000), large(1000), ret_small, ret_large;
+	for(std::size_t i = 0; i < small.size(); i++){
+		small[i] = (std::uint32_t)(i * 7 % 128);
+		large[i] = (std::uint32_t)(i * 2654435761u);
+	}
+	file.write_varint(small);
+	file.write_varint(large);
+	file.read_varint(ret_small);
+	file.read_varint(ret_large);
+	std::string equal = ret_small == small && ret_large == large ? "[success] : " : "[failure] : ";
+	std::cout << equal << "single byte and multi byte runs" << std::endl;
+	file.cleanFile();
+	}
+	{
+	file.write(std::string(12, (char)0x80));
+	std::vector<int> ret;
+	bool threw = false;
+	try{
+		file.read_varint(ret);
+	} catch(const iGIO::IOfailure& e){
+		threw = true;
+	}
+	std::string equal = threw ? "[success] : " : "[failure] : ";
+	std::cout << equal << "overlong varint rejected" << std::endl;
+	file.cleanFile();
+	}
+	{
+	const bool forward = can_write_varint<iGIO&, std::forward_list<int>::iterator, std::forward_list<int>::iterator>::value;
+	const bool single_pass = can_write_varint<iGIO&, std::istream_iterator<int>, std::istream_iterator<int>>::value;
+	std::string equal = forward && !single_pass ? "[success] : " : "[failure] : ";
+	std::cout << equal << "write_varint takes forward iterators, not single pass ones" << std::endl;
+	}
+}
+
+void Columns_test(){
+	std::cout << "\n[Columns test]" << std::endl;
+	std::vector<test_struct> test;
+	for(int i = 0; i < 50000; i++)
+		test.push_back(test_struct{i, 50, i % 3, 100});
+	{
+	const std::size_t rows = file.write_columns(test, &test_struct::a, &test_struct::b, &test_struct::c, &test_struct::d);
+	file << "end" << std::endl;
+	std::vector<test_struct> ret_test;
+	std::string end;
+	file.read_columns(ret_test, &test_struct::a, &test_struct::b, &test_struct::c, &test_struct::d);
+	file.read_until(end, '\n');
+	std::string equal = rows == test.size() && std::equal(test.begin(), test.end(), ret_test.begin()) && ret_test.size() == test.size() && end == "end\n" ? "[success] : " : "[failure] : ";
+	std::cout << equal << rows << " rows reassembled from 4 columns" << std::endl;
+	file.cleanFile();
+	}
+	{
+	std::list<test_struct> listed(test.begin(), test.begin() + 10);
+	file.write_columns(listed, &test_struct::c, &test_struct::a);
+	file << "end" << std::endl;
+	std::deque<test_struct> ret_test(3, test_struct{-1, -1, -1, -1});
+	std::string end;
+	file.read_columns(ret_test, nullptr, &test_struct::a);
+	file.read_until(end, '\n');
+	bool projected = ret_test.size() == listed.size() && end == "end\n";
+	for(std::size_t i = 0; i < ret_test.size(); i++)
+		projected = projected && ret_test[i].a == (int)i && ret_test[i].c == (i < 3 ? -1 : 0);
+	std::string equal = projected ? "[success] : " : "[failure] : ";
+	std::cout << equal << "projection of the second column" << std::endl;
+	file.cleanFile();
+	}
+	{
+	file.write(std::string_view("head"));
+	file.write_columns(test, &test_struct::a, &test_struct::b, &test_struct::c, &test_struct::d);
+	std::vector<test_struct> ret_test;
+	file.read_columns_at(4, ret_test, nullptr, nullptr, &test_struct::c);
+	bool projected = ret_test.size() == test.size();
+	for(std::size_t i = 0; projected && i < ret_test.size(); i++)
+		projected = ret_test[i].c == test[i].c && ret_test[i].a == 0;
+	bool threw = false;
+	try{
+		std::vector<test_struct> wrong;
+		file.read_columns_at(4, wrong, &test_struct::a, nullptr, nullptr, nullptr, nullptr);
+	} catch(const iGIO::IOfailure& e){
+		threw = true;
+	}
+	std::string equal = projected && threw ? "[success] : " : "[failure] : ";
+	std::cout << equal << "positional projection of the third column, " << ret_test.size() << " rows" << std::endl;
+	file.cleanFile();
+	}
+}
+
+void RLE_test(){
+	std::cout << "\n[RLE test]" << std::endl;
+	{
+	int v2[4] = {};
+	int ret_v2[4] = {1, 1, 1, 1};
+	file.write_rle(v2);
+	const std::uint64_t encoded = file.size();
+	file.read_rle(ret_v2);
+	std::string equal = std::equal(std::begin(v2), std::end(v2), std::begin(ret_v2)) && encoded < sizeof(v2) ? "[success] : " : "[failure] : ";
+	std::cout << equal << "zero array in " << encoded << " bytes: ";
+	print_arr(ret_v2, 4);
+	file.cleanFile();
+	}
+	std::vector<std::uint16_t> frame(100000, 0);
+	for(std::size_t i = 0; i < frame.size(); i += 997)
+		frame[i] = (std::uint16_t)(i | 1);
+	std::vector<double> histogram(50000, 1.5);
+	std::fill(histogram.begin() + 20000, histogram.begin() + 30000, 0.0);
+	std::vector<std::uint64_t> noise(10000);
+	for(std::size_t i = 0; i < noise.size(); i++)
+		noise[i] = i * 0x9E3779B97F4A7C15ull;
+	std::array<std::int32_t, 1000> pattern;
+	for(std::size_t i = 0; i < pattern.size(); i++)
+		pattern[i] = (std::int32_t)(i / 100) * 0x01020304;
+	{
+	file.write_rle(frame);
+	const std::uint64_t frame_bytes = file.size();
+	file.write_rle(histogram);
+	const std::uint64_t histogram_bytes = file.size() - frame_bytes;
+	file.write_rle(noise.data(), noise.size());
+	const std::uint64_t noise_bytes = file.size() - frame_bytes - histogram_bytes;
+	file.write_rle(pattern);
+	file << "end" << std::endl;
+	std::string equal = frame_bytes < 1000 && histogram_bytes < 200 && noise_bytes <= noise.size() * sizeof(std::uint64_t) + 32 ? "[success] : " : "[failure] : ";
+	std::cout << equal << "sparse frame in " << frame_bytes << " bytes, runs in " << histogram_bytes << " bytes, noise in " << noise_bytes << " bytes" << std::endl;
+	}
+	{
+	std::vector<std::uint16_t> ret_frame;
+	std::vector<double> ret_histogram(3, 2.0);
+	std::vector<std::uint64_t> ret_noise(noise.size());
+	std::array<std::int32_t, 1000> ret_pattern;
+	std::string end;
+	file.read_rle(ret_frame);
+	file.read_rle(ret_histogram);
+	const std::size_t n = file.read_rle(ret_noise.data(), ret_noise.size());
+	file.read_rle(ret_pattern);
+	file.read_until(end, '\n');
+	std::string equal = ret_frame == frame && ret_histogram == histogram && n == noise.size() && ret_noise == noise && ret_pattern == pattern && end == "end\n" ? "[success] : " : "[failure] : ";
+	std::cout << equal << "read back " << ret_frame.size() + ret_histogram.size() + n + ret_pattern.size() << " elements" << std::endl;
+	file.cleanFile();
+	}
+	{
+	file.write_rle(frame);
+	std::uint16_t small[10];
+	bool threw = false;
+	try{
+		file.read_rle(small);
+	} catch(const iGIO::IOfailure& e){
+		threw = true;
+	}
+	std::string equal = threw ? "[success] : " : "[failure] : ";
+	std::cout << equal << "too many elements rejected" << std::endl;
+	file.cleanFile();
+	}
+	{
+	// 1 element of 4 bytes in a raw block claiming 24 bytes
+	file.write(std::string_view("\x01\x04\x04\x18"));
+	file.write(std::string(24, 'X'));
+	std::vector<int> one(1);
+	bool threw = false;
+	try{
+		file.read_rle(one.data(), one.size());
+	} catch(const iGIO::IOfailure& e){
+		threw = true;
+	}
+	file.cleanFile();
+	// 2^50 elements of 4 bytes followed by a single block of 1 element
+	file.write(std::string_view("\x80\x80\x80\x80\x80\x80\x80\x02\x04\x05\x05\x01\x07\x00\x00\x00", 16));
+	std::vector<int> ret_test;
+	bool bounded = false;
+	try{
+		file.read_rle(ret_test);
+	} catch(const iGIO::IOfailure& e){
+		bounded = ret_test.size() == 1 && ret_test[0] == 7;
+	}
+	std::string equal = threw && one[0] == 0 && bounded ? "[success] : " : "[failure] : ";
+	std::cout << equal << "corrupt raw block length and element count rejected" << std::endl;
+	file.cleanFile();
+	}
 }
 
 void Until_Pointer_arr_test(){
@@ -934,8 +2483,31 @@ int main(){
 	Array_test();
 	Range_test();
 	Container_test();
+	NDimensional_test();
 	String_test();
+	View_test();
 	Stream_test();
+	Streambuf_test();
+	Record_test();
+	Text_test();
+	Transfer_test();
+	Positional_test();
+	RecordLog_test();
+	LineIndex_test();
+	ParallelReader_test();
+	ParallelCodec_test();
+	BufferPool_test();
+	DirectIO_test();
+	Durability_test();
+	Hints_test();
+	CachedIO_test();
+	Filter_test();
+	LZ_test();
+	CRC32C_test();
+	ChaCha20_test();
+	Varint_test();
+	Columns_test();
+	RLE_test();
 
 	Until_Pointer_arr_test();
 	Until_Array_test();